@@ -52,7 +52,12 @@ bool ActionButton::isInGroup() const { return (group); }
 bool ActionButton::isPressedInGroup() const { return isInGroup() && group->getPressed() == this; }
 
 
-void ActionButton::setButtonStatus(BUTTON_STATUS new_status) { status = new_status; };
+void ActionButton::setButtonStatus(BUTTON_STATUS new_status) {
+    if (status == new_status) return;
+
+    status = new_status;
+    invalidate();
+}
 
 
 void ActionButton::setButtonGroup(ButtonGroup *group_) {
@@ -280,7 +285,7 @@ void RectButton::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
 TextureButton::TextureButton(
     size_t id_, const plug::LayoutBox &layout_,
     ButtonAction *action_,
-    const plug::Texture &normal_, const plug::Texture &hover_, const plug::Texture &pressed_
+    const TextureRegion &normal_, const TextureRegion &hover_, const TextureRegion &pressed_
 ) :
     ActionButton(id_, layout_, action_),
     normal(normal_), hover(hover_), pressed(pressed_)
@@ -320,8 +325,8 @@ void TextureButton::draw(plug::TransformStack &stack, plug::RenderTarget &result
 TextureIconButton::TextureIconButton(
     size_t id_, const plug::LayoutBox &layout_,
     ButtonAction *action_,
-    const plug::Texture &normal_, const plug::Texture &hover_, const plug::Texture &pressed_,
-    const plug::Texture &icon_
+    const TextureRegion &normal_, const TextureRegion &hover_, const TextureRegion &pressed_,
+    const TextureRegion &icon_
 ) : 
     TextureButton(id_, layout_, action_, normal_, hover_, pressed_),
     icon(icon_)
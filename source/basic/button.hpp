@@ -275,15 +275,15 @@ public:
 /// plug::Texture button
 class TextureButton : public ActionButton {
 protected:
-    const plug::Texture &normal;
-    const plug::Texture &hover;
-    const plug::Texture &pressed;
+    TextureRegion normal;
+    TextureRegion hover;
+    TextureRegion pressed;
 
 public:
     TextureButton(
         size_t id_, const plug::LayoutBox &layout_,
         ButtonAction *action_,
-        const plug::Texture &normal_, const plug::Texture &hover_, const plug::Texture &pressed_
+        const TextureRegion &normal_, const TextureRegion &hover_, const TextureRegion &pressed_
     );
 
     virtual bool isInsideButton(const plug::Vec2d &point, const plug::Vec2d &global_size) const override;
@@ -295,7 +295,7 @@ public:
 /// Draws TextureButton with icon in front of it
 class TextureIconButton : public TextureButton {
 protected:
-    const plug::Texture &icon;
+    TextureRegion icon;
 
 public:
     /**
@@ -304,8 +304,8 @@ public:
     TextureIconButton(
         size_t id_, const plug::LayoutBox &layout_,
         ButtonAction *action_,
-        const plug::Texture &normal_, const plug::Texture &hover_, const plug::Texture &pressed_,
-        const plug::Texture &icon_
+        const TextureRegion &normal_, const TextureRegion &hover_, const TextureRegion &pressed_,
+        const TextureRegion &icon_
     );
 
     /**
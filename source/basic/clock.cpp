@@ -6,6 +6,7 @@
 
 #include <ctime>
 #include "basic/clock.hpp"
+#include "widget/frame_scheduler.hpp"
 
 
 // ============================================================================
@@ -53,9 +54,15 @@ void Clock::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
 void Clock::onTick(const plug::TickEvent &event, plug::EHC &ehc) {
     time_passed += event.delta_time;
 
-    if (time_passed > 1) {
-        time_passed = 0;
-        daytime++;
-        daytime %= 24 * 60 * 60;
+    if (time_passed >= 1) {
+        // TICKS ARE NOT PERIODIC IN IDLE MODE SO SEVERAL SECONDS CAN PASS AT ONCE
+        size_t seconds = time_passed;
+        time_passed -= seconds;
+
+        daytime = (daytime + seconds) % (24 * 60 * 60);
+
+        invalidate();
     }
+
+    FRAME_SCHEDULER.requestWakeUp(1 - time_passed);
 }
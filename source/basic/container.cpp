@@ -28,15 +28,62 @@ void Container::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
 
     TransformApplier add_transform(stack, getTransform());
 
-    for (size_t i = 0; i < widgets.size(); i++) {
+    List<bool> is_visible(widgets.size(), false);
+    markVisibleWidgets(is_visible);
+
+    // CHILDREN OUTSIDE OF THE CLIP ARE REJECTED BEFORE THEY GENERATE ANY VERTICES
+    const RenderTarget *target = dynamic_cast<const RenderTarget*>(&result);
+    if (target) rejectClippedWidgets(is_visible, stack, *target);
+
+    for (size_t i = 0; i < widgets.size(); i++)
+        if (is_visible[i]) widgets[i]->render(stack, result);
+}
+
+
+void Container::markVisibleWidgets(List<bool> &is_visible) const {
+    List<Rect> opaque_rects;
+
+    // WIDGETS ARE CHECKED FROM TOP TO BOTTOM, SO ONLY WIDGETS ABOVE CAN COVER CURRENT ONE
+    for (size_t i = widgets.size(); i-- > 0;) {
         switch (widgets[i]->getStatus()) {
             case Status::Normal:
             case Status::Disabled:
-                widgets[i]->draw(stack, result);
                 break;
-            
-            default: break;
+
+            default: continue;
         };
+
+        Rect rect = widgets[i]->getGlobalRect();
+
+        bool is_covered = false;
+        for (size_t j = 0; j < opaque_rects.size() && !is_covered; j++)
+            is_covered = !rect.isEmpty() && opaque_rects[j].contains(rect);
+
+        if (is_covered) continue;
+
+        is_visible[i] = true;
+
+        if (widgets[i]->isOpaque()) opaque_rects.push_back(rect);
+    }
+}
+
+
+void Container::rejectClippedWidgets(
+    List<bool> &is_visible,
+    const plug::TransformStack &stack, const RenderTarget &target
+) const {
+    // LAYERED WINDOWS DRAW WITH OFFSET, SO GLOBAL RECTS ARE SHIFTED TO TARGET COORDINATES
+    plug::Vec2d offset = stack.apply(plug::Vec2d()) - Widget::getGlobalRect().position;
+
+    Rect clip = target.getClip();
+
+    for (size_t i = 0; i < widgets.size(); i++) {
+        if (!is_visible[i]) continue;
+
+        Rect rect = widgets[i]->getGlobalRect();
+        rect.position += offset;
+
+        if (!rect.isEmpty() && intersect(rect, clip).isEmpty()) is_visible[i] = false;
     }
 }
 
@@ -66,6 +113,8 @@ size_t Container::addChild(Widget *child) {
 void Container::removeWidget(size_t index) {
     ASSERT(index < widgets.size(), "Index is out of range!\n");
 
+    widgets[index]->invalidate();
+
     delete widgets[index];
     widgets.remove(index);
 }
@@ -80,6 +129,9 @@ void Container::setFocused(size_t index) {
     widgets.remove(index);
     
     widgets.push_back(widget);
+
+    // WIDGET IS DRAWN ON TOP OF OTHERS NOW
+    if (index + 1 < widgets.size()) widget->invalidate();
 }
 
 
@@ -139,6 +191,31 @@ void Container::checkChildren() {
 }
 
 
+bool Container::drawsOver(const Widget &child, const Rect &rect) const {
+    size_t index = 0;
+    while (index < widgets.size() && widgets[index] != &child) index++;
+
+    return hasChildOver(rect, index + 1);
+}
+
+
+bool Container::hasChildOver(const Rect &rect, size_t first) const {
+    for (size_t i = first; i < widgets.size(); i++) {
+        switch (widgets[i]->getStatus()) {
+            case Status::Normal:
+            case Status::Disabled:
+                break;
+
+            default: continue;
+        };
+
+        if (!intersect(widgets[i]->getGlobalRect(), rect).isEmpty()) return true;
+    }
+
+    return false;
+}
+
+
 Container::~Container() {
     for (size_t i = 0; i < widgets.size(); i++) {
         ASSERT(widgets[i], "Pointer to widget is nullptr!\n");
@@ -8,6 +8,7 @@
 #define _CONTAINER_H_
 
 
+#include "widget/render_target.hpp"
 #include "widget/widget.hpp"
 
 
@@ -64,12 +65,35 @@ public:
     */
     virtual void checkChildren() override;
 
+    /**
+     * \brief Returns true if some child drawn after the given one overlaps rectangle
+    */
+    virtual bool drawsOver(const Widget &child, const Rect &rect) const override;
+
+    /**
+     * \brief Returns true if some drawn child starting from index first overlaps rectangle
+    */
+    bool hasChildOver(const Rect &rect, size_t first = 0) const;
+
     /**
      * \brief Deletes children
     */
     ~Container();
 
 protected:
+    /**
+     * \brief Marks widgets that are drawn and not covered by opaque widgets above them
+    */
+    void markVisibleWidgets(List<bool> &is_visible) const;
+
+    /**
+     * \brief Unmarks widgets that are completely outside of target clip
+    */
+    void rejectClippedWidgets(
+        List<bool> &is_visible,
+        const plug::TransformStack &stack, const RenderTarget &target
+    ) const;
+
     /**
      * \brief Removes widget by its index in widgets array
     */
@@ -5,6 +5,7 @@
 
 
 #include "basic/line_edit.hpp"
+#include "widget/frame_scheduler.hpp"
 
 
 // ============================================================================
@@ -26,6 +27,7 @@ LineEdit::LineEdit(
 void LineEdit::setCursorVisible() {
     is_cursor_hidden = false;
     blink_time = 0;
+    invalidate();
 }
 
 
@@ -60,6 +62,7 @@ void LineEdit::setString(const char *new_str) {
     str.assign(new_str);
     text.setText(new_str);
     cursor_pos = 0;
+    invalidate();
 }
 
 
@@ -70,6 +73,7 @@ const LineEditStyle &LineEdit::getStyle() const {
 
 void LineEdit::setStyle(const LineEditStyle &new_style) {
     style = new_style;
+    invalidate();
 }
 
 
@@ -79,11 +83,23 @@ void LineEdit::setKeyboardFocus(bool is_focused) {
         is_typing = true;
     }
     else {
+        if (is_typing) invalidate();
         is_typing = false;
     }
 }
 
 
+Rect LineEdit::getGlobalRect() const {
+    Rect rect = Widget::getGlobalRect();
+
+    // CURSOR IS HIGHER THAN TEXT AND CAN BE DRAWN AT THE RIGHT EDGE
+    rect.position.y -= CURSOR_OFFSET;
+    rect.size += plug::Vec2d(CURSOR_WIDTH, CURSOR_OFFSET * 2);
+
+    return rect;
+}
+
+
 void LineEdit::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
     plug::Vec2d global_position = stack.apply(layout->getPosition());
     plug::Vec2d global_size = applySize(stack, layout->getSize());
@@ -196,10 +212,17 @@ void LineEdit::onKeyboardPressed(const plug::KeyboardPressedEvent &event, plug::
 
 
 void LineEdit::onTick(const plug::TickEvent &event, plug::EHC &ehc) {
+    // CURSOR IS DRAWN ONLY WHILE TYPING SO HIDDEN BLINKS ARE NOT WORTH WAKING UP FOR
+    if (!is_typing) return;
+
     blink_time += event.delta_time;
 
-    if (blink_time > CURSOR_BLINK_TIME) {
+    if (blink_time >= CURSOR_BLINK_TIME) {
         is_cursor_hidden = !is_cursor_hidden;
         blink_time = 0;
+
+        invalidate();
     }
+
+    FRAME_SCHEDULER.requestWakeUp(CURSOR_BLINK_TIME - blink_time);
 }
@@ -99,6 +99,11 @@ public:
     */
     void setKeyboardFocus(bool is_focused);
 
+    /**
+     * \brief Returns widget region including cursor
+    */
+    virtual Rect getGlobalRect() const override;
+
     /**
      * \brief Draws buffer content and cursor
     */
@@ -107,6 +112,7 @@ public:
 protected:
     /**
      * \brief Resets blink time to zero and sets cursor visible
+     * \note Damages widget region
     */
     void setCursorVisible();
 
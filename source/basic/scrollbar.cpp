@@ -96,6 +96,7 @@ void VScrollBar::scrollTo(const plug::Vec2d &shift) {
     if (new_position.y + scroller.getSize().y > size.y) new_position.y = size.y - scroller.getSize().y;
 
     scroller.setPosition(new_position);
+    invalidate();
 
     (*action)(new_position.y / (size.y - scroller.getSize().y));
 }
@@ -133,6 +134,7 @@ void HScrollBar::scrollTo(const plug::Vec2d &shift) {
     if (new_position.x + scroller.getSize().x > size.x) new_position.x = size.x - scroller.getSize().x;
 
     scroller.setPosition(new_position);
+    invalidate();
 
     (*action)(new_position.x / (size.x - scroller.getSize().x));
 }
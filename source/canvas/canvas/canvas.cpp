@@ -4,84 +4,291 @@
 */
 
 
-#include <cstring>
+#include <algorithm>
 #include "common/assert.hpp"
 #include "canvas/canvas/canvas.hpp"
 #include "canvas/palettes/palette_manager.hpp"
+#include "widget/render_fence.hpp"
 
 
 // ============================================================================
 
 
-SFMLCanvas::SFMLCanvas() :
-    render_texture(), selection_mask(nullptr), buffer_texture(nullptr) {}
+SoftwareCanvas::SoftwareCanvas() :
+    target(), selection_mask(nullptr), revision(0) {}
 
 
-void SFMLCanvas::draw(const plug::VertexArray& vertex_array) {
-    render_texture.draw(vertex_array);
+void SoftwareCanvas::draw(const plug::VertexArray& vertex_array) {
+    target.draw(vertex_array);
+    markModified();
 }
 
 
-void SFMLCanvas::draw(const plug::VertexArray& vertex_array, const plug::Texture& texture) {
-    render_texture.draw(vertex_array, texture);
+void SoftwareCanvas::draw(const plug::VertexArray& vertex_array, const plug::Texture& texture) {
+    target.draw(vertex_array, texture);
+    markModified();
 }
 
 
-plug::Vec2d SFMLCanvas::getSize() const { return render_texture.getSize(); }
+plug::Vec2d SoftwareCanvas::getSize() const { return target.getSize(); }
+
+
+void SoftwareCanvas::setSize(const plug::Vec2d& size) {
+    setSize(size, COLOR_PALETTE.getBGColor());
+}
 
 
-void SFMLCanvas::setSize(const plug::Vec2d& size) {
+void SoftwareCanvas::setSize(const plug::Vec2d& size, const plug::Color &color) {
     if (selection_mask) delete selection_mask;
-    if (buffer_texture) delete buffer_texture;
 
-    render_texture.create(size.x, size.y);
+    target.create(size.x, size.y);
+    target.clear(color);
 
     selection_mask = new SelectionMask(size.x, size.y);
     ASSERT(selection_mask, "Failed to allocate selection mask!\n");
 
     selection_mask->fill(true);
-
-    buffer_texture = new plug::Texture(size.x, size.y);
-    ASSERT(buffer_texture, "Failed to allocate buffer texture!\n");
-
-    for (size_t i = 0; i < buffer_texture->width * buffer_texture->height; i++)
-        buffer_texture->data[i] = COLOR_PALETTE.getBGColor();
-    
-    TextureShape(*buffer_texture).draw(render_texture, plug::Vec2d(), size);
+    markModified();
 }
 
 
-plug::SelectionMask& SFMLCanvas::getSelectionMask() {
+plug::SelectionMask& SoftwareCanvas::getSelectionMask() {
     ASSERT(selection_mask, "Init canvas first!\n");
     return *selection_mask;
 }
 
 
-plug::Color SFMLCanvas::getPixel(size_t x, size_t y) const {
-    return buffer_texture->getPixel(x, y);
+plug::Color SoftwareCanvas::getPixel(size_t x, size_t y) const {
+    return target.getPixel(x, y);
 }
 
 
-void SFMLCanvas::setPixel(size_t x, size_t y, const plug::Color& color) {
-    plug::VertexArray array(plug::Points, 1);
-    array[0] = plug::Vertex(plug::Vec2d(x, y), color);
-    render_texture.draw(array);
+void SoftwareCanvas::copyPixels(size_t x, size_t y, size_t width, size_t height, plug::Color *pixels) const {
+    target.getPixels().copyTo(pixels, x, y, width, height);
 }
 
 
-const plug::Texture &SFMLCanvas::getTexture() const {
-    const plug::Texture &texture = render_texture.getTexture();
+void SoftwareCanvas::setPixel(size_t x, size_t y, const plug::Color& color) {
+    target.setPixel(x, y, color);
+    markModified();
+}
 
-    memcpy(buffer_texture->data, texture.data, texture.width * texture.height * 4);
 
-    return texture;
+void SoftwareCanvas::setPixels(size_t x, size_t y, size_t width, size_t height, const plug::Color *pixels) {
+    target.getPixels().write(pixels, x, y, width, height);
+    markModified();
 }
 
 
-SFMLCanvas::~SFMLCanvas() {
+void SoftwareCanvas::fillSpan(size_t x, size_t y, size_t length, const plug::Color &color) {
+    target.getPixels().fill(x, y, x + length, y + 1, color);
+    markModified();
+}
+
+
+void SoftwareCanvas::setPixelsMasked(
+    size_t x, size_t y, size_t width, size_t height,
+    const plug::Color *pixels, const plug::SelectionMask &mask
+) {
+    TiledTexture &tiles = target.getPixels();
+
+    for (size_t j = 0; j < height; j++) {
+        // SELECTED PIXELS ARE WRITTEN BY RUNS, SO UNSELECTED TILES STAY SHARED
+        size_t begin = x, end = x;
+
+        while (end < x + width && mask.findRun(end, y + j, begin, end) && begin < x + width) {
+            end = std::min(end, x + width);
+            tiles.write(pixels + j * width + begin - x, begin, y + j, end - begin, 1);
+        }
+    }
+
+    markModified();
+}
+
+
+const plug::Texture &SoftwareCanvas::getTexture() const { return target.getTexture(); }
+
+
+const TiledTexture &SoftwareCanvas::getPixels() const { return target.getPixels(); }
+
+
+TiledTexture SoftwareCanvas::getSnapshot() const { return target.getPixels(); }
+
+
+void SoftwareCanvas::restoreSnapshot(const TiledTexture &snapshot) {
+    target.setPixels(snapshot);
+    markModified();
+}
+
+
+size_t SoftwareCanvas::getRevision() const { return revision; }
+
+
+bool SoftwareCanvas::saveToFile(const char *filename) const {
+    const TiledTexture &pixels = target.getPixels();
+    size_t width = pixels.getWidth(), height = pixels.getHeight();
+
+    sf::Image image;
+    image.create(width, height);
+
+    // ONLY THE IMAGE ITSELF HAS FULL SIZE, CANVAS IS COPIED TO IT BY STRIPS
+    plug::Texture strip(width, TEXTURE_TILE_SIZE);
+    sf::Image strip_image;
+
+    for (size_t y = 0; y < height; y += TEXTURE_TILE_SIZE) {
+        size_t strip_height = std::min(TEXTURE_TILE_SIZE, height - y);
+
+        pixels.copyTo(strip.data, 0, y, width, strip_height);
+
+        strip_image.create(width, strip_height, reinterpret_cast<const uint8_t*>(strip.data));
+        image.copy(strip_image, 0, y);
+    }
+
+    return image.saveToFile(filename);
+}
+
+
+void SoftwareCanvas::markModified() {
+    // ASSEMBLED TEXTURE IS KEPT, PLUGINS CAN HOLD IT WHILE WRITING PIXELS AND IT IS REFRESHED BY TILE STAMPS
+    revision++;
+}
+
+
+SoftwareCanvas::~SoftwareCanvas() {
     if (selection_mask)
         delete selection_mask;
-    
-    if (buffer_texture)
-        delete buffer_texture;
+}
+
+
+// ============================================================================
+
+
+SFMLCanvas::SFMLCanvas() :
+    SoftwareCanvas(),
+    cells(), cell_size(0), cell_columns(0), cell_revisions(), uploaded_stamps(), upload_buffer(nullptr) {}
+
+
+void SFMLCanvas::setSize(const plug::Vec2d& size, const plug::Color &color) {
+    SoftwareCanvas::setSize(size, color);
+
+    deleteCells();
+
+    // CELLS CONSIST OF WHOLE TILES, SO EVERY TILE IS UPLOADED TO ONE TEXTURE
+    cell_size = std::max<size_t>(sf::Texture::getMaximumSize() / TEXTURE_TILE_SIZE, 1) * TEXTURE_TILE_SIZE;
+
+    size_t width = size.x, height = size.y;
+    cell_columns = (width + cell_size - 1) / cell_size;
+
+    for (size_t y = 0; y < height; y += cell_size) {
+        for (size_t x = 0; x < width; x += cell_size) {
+            sf::Texture *cell = new sf::Texture();
+            ASSERT(cell, "Failed to allocate canvas cell!\n");
+
+            ASSERT(
+                cell->create(std::min(cell_size, width - x), std::min(cell_size, height - y)),
+                "Failed to create canvas cell!\n"
+            );
+
+            cells.push_back(cell);
+        }
+    }
+
+    // ZERO REVISION AND STAMP NEVER MATCH, SO EVERYTHING IS UPLOADED
+    cell_revisions = List<size_t>(cells.size(), 0);
+    uploaded_stamps = List<size_t>(getPixels().getColumns() * getPixels().getRows(), 0);
+
+    if (upload_buffer) delete upload_buffer;
+
+    upload_buffer = new plug::Texture(std::min(cell_size, width), TEXTURE_TILE_SIZE);
+    ASSERT(upload_buffer, "Failed to allocate upload buffer!\n");
+}
+
+
+size_t SFMLCanvas::getCellCount() const { return cells.size(); }
+
+
+Rect SFMLCanvas::getCellRect(size_t index) const {
+    ASSERT(index < cells.size(), "Cell index is out of range!\n");
+
+    sf::Vector2u size = cells[index]->getSize();
+
+    return Rect(
+        plug::Vec2d((index % cell_columns) * cell_size, (index / cell_columns) * cell_size),
+        plug::Vec2d(size.x, size.y)
+    );
+}
+
+
+const sf::Texture &SFMLCanvas::getCellTexture(size_t index) const {
+    ASSERT(index < cells.size(), "Cell index is out of range!\n");
+
+    // CANVAS IS DRAWN EVERY FRAME, SO UNCHANGED CANVAS IS NOT SCANNED
+    if (cell_revisions[index] != getRevision()) {
+        uploadCell(index);
+        cell_revisions[index] = getRevision();
+    }
+
+    return *cells[index];
+}
+
+
+void SFMLCanvas::uploadCell(size_t index) const {
+    // CELL CAN BE IN FRAME THAT RENDER THREAD REPLAYS
+    RENDER_FENCE.wait();
+
+    const TiledTexture &pixels = getPixels();
+    size_t tiles_in_cell = cell_size / TEXTURE_TILE_SIZE;
+
+    size_t first_column = (index % cell_columns) * tiles_in_cell;
+    size_t first_row = (index / cell_columns) * tiles_in_cell;
+
+    size_t end_column = std::min(first_column + tiles_in_cell, pixels.getColumns());
+    size_t end_row = std::min(first_row + tiles_in_cell, pixels.getRows());
+
+    for (size_t row = first_row; row < end_row; row++) {
+        size_t first = end_column, last = 0;
+
+        for (size_t column = first_column; column < end_column; column++) {
+            size_t stamp = pixels.getStamp(column, row);
+            if (uploaded_stamps[row * pixels.getColumns() + column] == stamp) continue;
+
+            uploaded_stamps[row * pixels.getColumns() + column] = stamp;
+
+            first = std::min(first, column);
+            last = column;
+        }
+
+        if (first == end_column) continue;
+
+        // CHANGED TILES OF THE ROW ARE SENT AS ONE RECTANGLE
+        size_t x = first * TEXTURE_TILE_SIZE;
+        size_t y = row * TEXTURE_TILE_SIZE;
+        size_t width = std::min((last + 1) * TEXTURE_TILE_SIZE, pixels.getWidth()) - x;
+        size_t height = std::min(TEXTURE_TILE_SIZE, pixels.getHeight() - y);
+
+        pixels.copyTo(upload_buffer->data, x, y, width, height);
+
+        cells[index]->update(
+            reinterpret_cast<const uint8_t*>(upload_buffer->data), width, height,
+            x - first_column * TEXTURE_TILE_SIZE, y - first_row * TEXTURE_TILE_SIZE
+        );
+    }
+}
+
+
+void SFMLCanvas::deleteCells() {
+    RENDER_FENCE.wait();
+
+    for (size_t i = 0; i < cells.size(); i++)
+        delete cells[i];
+
+    cells = List<sf::Texture*>();
+}
+
+
+SFMLCanvas::~SFMLCanvas() {
+    deleteCells();
+
+    if (upload_buffer)
+        delete upload_buffer;
 }
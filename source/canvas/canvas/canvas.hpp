@@ -8,18 +8,19 @@
 #define _CANVAS_H_
 
 
-#include <widget/render_target.hpp>
+#include <widget/software_target.hpp>
 #include <canvas/canvas/selection_mask.hpp>
 #include "standart/Canvas.h"
 
 
-class SFMLCanvas  : public plug::Canvas {
+/// Canvas that is drawn on CPU, so it works without OpenGL context
+class SoftwareCanvas : public plug::Canvas {
 public:
-    SFMLCanvas();
+    SoftwareCanvas();
 
-    SFMLCanvas(const SFMLCanvas&) = delete;
-    
-    SFMLCanvas &operator = (const SFMLCanvas&) = delete;
+    SoftwareCanvas(const SoftwareCanvas&) = delete;
+
+    SoftwareCanvas &operator = (const SoftwareCanvas&) = delete;
 
     virtual void draw(const plug::VertexArray& vertex_array) override;
 
@@ -27,22 +28,152 @@ public:
 
     virtual plug::Vec2d getSize() const override;
 
+    /**
+     * \brief Recreates canvas filled with background color of color palette
+    */
     virtual void setSize(const plug::Vec2d& size) override;
 
+    /**
+     * \brief Recreates canvas filled with color and selects all pixels
+    */
+    virtual void setSize(const plug::Vec2d& size, const plug::Color &color);
+
     virtual plug::SelectionMask& getSelectionMask() override;
 
     virtual plug::Color getPixel(size_t x, size_t y) const override;
 
     virtual void setPixel(size_t x, size_t y, const plug::Color& color) override;
 
+    /**
+     * \brief Copies rectangle of pixels row by row directly from canvas tiles
+    */
+    virtual void copyPixels(size_t x, size_t y, size_t width, size_t height, plug::Color *pixels) const override;
+
+    /**
+     * \brief Copies rectangle of pixels row by row directly to canvas tiles
+    */
+    virtual void setPixels(size_t x, size_t y, size_t width, size_t height, const plug::Color *pixels) override;
+
+    /**
+     * \brief Fills row of pixels directly in canvas tiles
+    */
+    virtual void fillSpan(size_t x, size_t y, size_t length, const plug::Color &color) override;
+
+    /**
+     * \brief Copies runs of selected pixels directly to canvas tiles
+    */
+    virtual void setPixelsMasked(
+        size_t x, size_t y, size_t width, size_t height,
+        const plug::Color *pixels, const plug::SelectionMask &mask
+    ) override;
+
+    /**
+     * \brief Returns canvas pixels assembled into one texture
+     * \note Texture is allocated on the first call and lives until canvas is resized,
+     * later calls copy only tiles changed since the previous one
+    */
     virtual const plug::Texture &getTexture() const override;
 
-    virtual ~SFMLCanvas() override;
+    /**
+     * \brief Returns tiled canvas pixels
+    */
+    const TiledTexture &getPixels() const;
+
+    /**
+     * \brief Returns copy of canvas pixels that shares tiles with canvas
+     * \note Snapshot takes memory only for tiles that are changed on canvas after it
+    */
+    TiledTexture getSnapshot() const;
+
+    /**
+     * \brief Makes canvas pixels equal to snapshot sharing tiles with it
+     * \warning Snapshot must have the same size as the canvas
+    */
+    void restoreSnapshot(const TiledTexture &snapshot);
+
+    /**
+     * \brief Returns counter that increases on every canvas modification
+    */
+    size_t getRevision() const;
+
+    /**
+     * \brief Saves canvas to image file copying pixels by strips of tile rows
+     * \return false if image can not be saved
+    */
+    bool saveToFile(const char *filename) const;
+
+    virtual ~SoftwareCanvas() override;
 
 private:
-    RenderTexture render_texture;           ///< Texture to draw on
+    /**
+     * \brief Increases revision
+    */
+    void markModified();
+
+    SoftwareRenderTarget target;            ///< Target to draw on
     plug::SelectionMask *selection_mask;    ///< Canvas selection mask
-    plug::Texture *buffer_texture;          ///< Texture for boosting getPixel
+    size_t revision;                        ///< Modification counter
+};
+
+
+/**
+ * \brief Canvas that is drawn on CPU and mirrored to GPU textures for fast drawing on screen
+ * \note CPU pixels are the only source of truth, GPU textures are updated only in changed tiles
+ * \note GPU copy is split into grid of cells no bigger than maximum texture size, so canvas size is not limited by GPU
+*/
+class SFMLCanvas : public SoftwareCanvas {
+public:
+    SFMLCanvas();
+
+    SFMLCanvas(const SFMLCanvas&) = delete;
+
+    SFMLCanvas &operator = (const SFMLCanvas&) = delete;
+
+    using SoftwareCanvas::setSize;
+
+    /**
+     * \brief Recreates canvas pixels and GPU cells
+    */
+    virtual void setSize(const plug::Vec2d& size, const plug::Color &color) override;
+
+    /**
+     * \brief Returns amount of GPU cells
+    */
+    size_t getCellCount() const;
+
+    /**
+     * \brief Returns region of canvas that cell holds
+    */
+    Rect getCellRect(size_t index) const;
+
+    /**
+     * \brief Returns GPU copy of cell region, texture coordinates start at cell corner
+     * \note Uploads tiles of this cell that changed since the last call
+    */
+    const sf::Texture &getCellTexture(size_t index) const;
+
+    /**
+     * \brief Deletes cells and upload buffer
+    */
+    virtual ~SFMLCanvas() override;
+
+private:
+    /**
+     * \brief Uploads changed tiles of cell merging tiles of each row into one rectangle
+    */
+    void uploadCell(size_t index) const;
+
+    /**
+     * \brief Deletes all cells
+    */
+    void deleteCells();
+
+    List<sf::Texture*> cells;               ///< GPU copies of canvas parts by rows
+    size_t cell_size;                       ///< Side of full cell in pixels
+    size_t cell_columns;                    ///< Amount of cell columns
+    mutable List<size_t> cell_revisions;    ///< Canvas revisions that are uploaded to cells
+    mutable List<size_t> uploaded_stamps;   ///< Stamps of tiles that are in GPU copy
+    mutable plug::Texture *upload_buffer;   ///< Row of tiles that is sent to GPU at once
 };
 
 
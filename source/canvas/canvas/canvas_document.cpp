@@ -0,0 +1,122 @@
+/**
+ * \file
+ * \brief Contains canvas document implementation
+*/
+
+
+#include <algorithm>
+#include "common/assert.hpp"
+#include "common/pixel_convert.hpp"
+#include "canvas/canvas/canvas_document.hpp"
+#include "canvas/palettes/palette_manager.hpp"
+
+
+/**
+ * \brief Draws translucent pixels over background color like alpha blending does
+ * \note Opaque pixels are left as is
+*/
+static void blendOverBackground(plug::Color *pixels, size_t count, const plug::Color &background);
+
+
+// ============================================================================
+
+
+CanvasDocument::CanvasDocument() :
+    canvas(), filename(""), references(1) {}
+
+
+bool CanvasDocument::createImage(size_t width, size_t height) {
+    // CANVAS IS CREATED FILLED WITH BACKGROUND COLOR, SO NOTHING IS DRAWN ON IT
+    canvas.setSize(plug::Vec2d(width, height), COLOR_PALETTE.getBGColor());
+    filename = "";
+
+    return true;
+}
+
+
+bool CanvasDocument::openImage(const char *filename_) {
+    sf::Image image;
+    if (image.loadFromFile(filename_)) {
+        size_t width = image.getSize().x, height = image.getSize().y;
+        createImage(width, height);
+
+        plug::Color background = COLOR_PALETTE.getBGColor();
+
+        // ONLY THE IMAGE ITSELF HAS FULL SIZE, IT IS COPIED TO CANVAS BY STRIPS
+        plug::Texture strip(width, TEXTURE_TILE_SIZE);
+
+        for (size_t y = 0; y < height; y += TEXTURE_TILE_SIZE) {
+            size_t strip_height = std::min(TEXTURE_TILE_SIZE, height - y);
+
+            convertRGBAToColors(strip.data, image.getPixelsPtr() + y * width * 4, width * strip_height);
+            blendOverBackground(strip.data, width * strip_height, background);
+
+            canvas.setPixels(0, y, width, strip_height, strip.data);
+        }
+
+        filename = filename_;
+        return true;
+    }
+
+    return false;
+}
+
+
+void CanvasDocument::saveImage() {
+    ASSERT(isImageOpen(), "File was not specified!\n");
+    saveImageAs(filename.data());
+}
+
+
+void CanvasDocument::saveImageAs(const char *filename_) {
+    canvas.saveToFile(filename_);
+    filename = filename_;
+}
+
+
+const char *CanvasDocument::getFilename() const {
+    return (isImageOpen()) ? filename.data() : nullptr;
+}
+
+
+bool CanvasDocument::isImageOpen() const {
+    return filename.length() > 0;
+}
+
+
+SFMLCanvas &CanvasDocument::getCanvas() { return canvas; }
+
+
+const SFMLCanvas &CanvasDocument::getCanvas() const { return canvas; }
+
+
+void CanvasDocument::addReference() { references++; }
+
+
+void CanvasDocument::release() {
+    ASSERT(references, "Document is already deleted!\n");
+
+    references--;
+    if (!references) delete this;
+}
+
+
+// ============================================================================
+
+
+static void blendOverBackground(plug::Color *pixels, size_t count, const plug::Color &background) {
+    for (size_t i = 0; i < count; i++) {
+        plug::Color color = pixels[i];
+        if (color.a == 255) continue;
+
+        unsigned inverse = 255 - color.a;
+
+        // SAME AS SFML BLEND ALPHA: SOURCE ALPHA IS ADDED TO THE REMAINING DESTINATION ALPHA
+        pixels[i] = plug::Color(
+            (color.r * color.a + background.r * inverse + 127) / 255,
+            (color.g * color.a + background.g * inverse + 127) / 255,
+            (color.b * color.a + background.b * inverse + 127) / 255,
+            color.a + (background.a * inverse + 127) / 255
+        );
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * \file
+ * \brief Contains canvas document interface
+*/
+
+
+#ifndef _CANVAS_DOCUMENT_H_
+#define _CANVAS_DOCUMENT_H_
+
+
+#include <string>
+#include "canvas/canvas/canvas.hpp"
+
+
+/**
+ * \brief Image that can be shown by several canvas views at once
+ * \note Document owns the only canvas and file path, views only keep references to it
+ * \note Document deletes itself when the last reference is released
+*/
+class CanvasDocument {
+public:
+    /**
+     * \brief Creates empty document with one reference
+    */
+    CanvasDocument();
+
+    CanvasDocument(const CanvasDocument&) = delete;
+
+    CanvasDocument &operator = (const CanvasDocument&) = delete;
+
+    /**
+     * \brief Creates image with the given size filled with background color
+    */
+    bool createImage(size_t width, size_t height);
+
+    /**
+     * \brief Opens image file
+     * \note If file fails to open, nothing happens
+    */
+    bool openImage(const char *filename_);
+
+    /**
+     * \brief Saves canvas to current image file
+     * \warning Assert will be called if image is not open
+    */
+    void saveImage();
+
+    /**
+     * \brief Saves canvas to path
+     * \note Changes filename field to filename_
+    */
+    void saveImageAs(const char *filename_);
+
+    /**
+     * \brief Returns path to current image
+     * \note Returns nullptr if image is not open
+    */
+    const char *getFilename() const;
+
+    /**
+     * \brief Returns true if image is open
+    */
+    bool isImageOpen() const;
+
+    /**
+     * \brief Returns document canvas
+    */
+    SFMLCanvas &getCanvas();
+
+    /**
+     * \brief Returns document canvas
+    */
+    const SFMLCanvas &getCanvas() const;
+
+    /**
+     * \brief Adds one more user of the document
+     * \note Every addReference() call must be paired with release()
+    */
+    void addReference();
+
+    /**
+     * \brief Removes one user of the document and deletes it if nobody uses it
+    */
+    void release();
+
+    /**
+     * \brief Deletes canvas
+     * \warning Use release() instead of deleting document directly
+    */
+    ~CanvasDocument() = default;
+
+private:
+    SFMLCanvas canvas;              ///< Shared canvas
+    std::string filename;           ///< Path to image or empty string
+    size_t references;              ///< Amount of document users
+};
+
+
+#endif
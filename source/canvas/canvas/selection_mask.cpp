@@ -4,26 +4,77 @@
 */
 
 
+#include <cstring>
 #include "common/assert.hpp"
 #include "canvas/canvas/selection_mask.hpp"
+#include "common/simd.hpp"
+
+
+const size_t WORD_BITS = 64;                ///< Amount of pixels in one word
+const uint64_t FULL_WORD = ~uint64_t(0);    ///< Word with all pixels selected
+
+
+/**
+ * \brief Operations that combine words of two masks
+*/
+enum class MaskOperation {
+    UNITE,          ///< Pixel is selected if it is selected in any mask
+    INTERSECT,      ///< Pixel is selected if it is selected in both masks
+    SUBTRACT,       ///< Pixel is selected if it is selected only in the first mask
+    INVERT,         ///< Pixel is selected if it is not selected in the first mask
+};
+
+
+/**
+ * \brief Combines words of the first mask with words of the second mask
+ * \note INVERT ignores the second mask
+*/
+template <MaskOperation OPERATION>
+static void combineWords(uint64_t *dst, const uint64_t *src, size_t count);
+
+
+/**
+ * \brief Combines single words
+*/
+template <MaskOperation OPERATION>
+static uint64_t combineWord(uint64_t dst, uint64_t src);
+
+
+#ifdef SIMD_KERNELS
+
+/**
+ * \brief Combines words by groups of 2
+ * \return Amount of processed words
+*/
+template <MaskOperation OPERATION>
+static size_t combineWordsSSE2(uint64_t *dst, const uint64_t *src, size_t count);
+
+
+/**
+ * \brief Combines words by groups of 4
+ * \return Amount of processed words
+*/
+template <MaskOperation OPERATION>
+AVX2_KERNEL static size_t combineWordsAVX2(uint64_t *dst, const uint64_t *src, size_t count);
+
+#endif
 
 
 // ============================================================================
 
 
 SelectionMask::SelectionMask(size_t width_, size_t height_) :
-    mask(nullptr), width(width_), height(height_) 
+    words(nullptr), width(width_), height(height_), row_words((width_ + WORD_BITS - 1) / WORD_BITS)
 {
-    mask = new bool[width * height];
-    ASSERT(mask, "Failed to allocate mask!\n");
+    words = new uint64_t[row_words * height]();
+    ASSERT(words, "Failed to allocate mask!\n");
 }
 
 
 bool SelectionMask::getPixel(size_t x, size_t y) const {
-    ASSERT(mask, "Mask is nullptr!\n");
-    ASSERT(x < width, "X is out of range!\n");
-    ASSERT(y < height, "Y is out of range!\n");
-    return mask[y * width + x];
+    ASSERT(x < width && y < height, "Pixel is out of mask!\n");
+
+    return (words[y * row_words + x / WORD_BITS] >> (x % WORD_BITS)) & 1;
 }
 
 
@@ -34,31 +85,175 @@ size_t SelectionMask::getHeight() const { return height; }
 
 
 void SelectionMask::setPixel(size_t x, size_t y, bool flag) {
-    ASSERT(mask, "Mask is nullptr!\n");
-    ASSERT(x < width, "X is out of range!\n");
-    ASSERT(y < height, "Y is out of range!\n");
-    mask[y * width + x] = flag;
+    ASSERT(x < width && y < height, "Pixel is out of mask!\n");
+
+    uint64_t &word = words[y * row_words + x / WORD_BITS];
+    uint64_t bit = uint64_t(1) << (x % WORD_BITS);
+
+    word = (flag) ? (word | bit) : (word & ~bit);
 }
 
 
 void SelectionMask::fill(bool value) {
-    ASSERT(mask, "Mask is nullptr!\n");
+    memset(words, (value) ? 0xFF : 0, row_words * height * sizeof(uint64_t));
 
-    size_t mask_size = width * height;
-    for (size_t i = 0; i < mask_size; i++)
-        mask[i] = value;
+    if (value) clearPadding();
 }
 
 
 void SelectionMask::invert() {
-    ASSERT(mask, "Mask is nullptr!\n");
+    combineWords<MaskOperation::INVERT>(words, words, row_words * height);
+
+    clearPadding();
+}
+
+
+bool SelectionMask::findRun(size_t x, size_t y, size_t &begin, size_t &end) const {
+    ASSERT(y < height, "Row is out of mask!\n");
+
+    if (x >= width) return false;
+
+    const uint64_t *row = words + y * row_words;
+    size_t index = x / WORD_BITS;
+
+    // BITS BEFORE X ARE DROPPED, THEN EMPTY WORDS ARE SKIPPED WHOLE
+    uint64_t word = row[index] & (FULL_WORD << (x % WORD_BITS));
+    while (!word) {
+        if (++index == row_words) return false;
+        word = row[index];
+    }
+
+    begin = index * WORD_BITS + __builtin_ctzll(word);
+
+    // RUN ENDS AT THE FIRST ZERO BIT, PADDING IS ZERO SO IT NEVER PASSES ROW END
+    word = ~row[index] & (FULL_WORD << (begin % WORD_BITS));
+    while (!word) {
+        if (++index == row_words) {
+            end = width;
+            return true;
+        }
+
+        word = ~row[index];
+    }
+
+    end = index * WORD_BITS + __builtin_ctzll(word);
+    return true;
+}
+
+
+void SelectionMask::unite(const SelectionMask &mask) {
+    ASSERT(width == mask.width && height == mask.height, "Masks have different sizes!\n");
 
-    size_t mask_size = width * height;
-    for (size_t i = 0; i < mask_size; i++)
-        mask[i] = !mask[i];
+    combineWords<MaskOperation::UNITE>(words, mask.words, row_words * height);
+}
+
+
+void SelectionMask::intersect(const SelectionMask &mask) {
+    ASSERT(width == mask.width && height == mask.height, "Masks have different sizes!\n");
+
+    combineWords<MaskOperation::INTERSECT>(words, mask.words, row_words * height);
+}
+
+
+void SelectionMask::subtract(const SelectionMask &mask) {
+    ASSERT(width == mask.width && height == mask.height, "Masks have different sizes!\n");
+
+    combineWords<MaskOperation::SUBTRACT>(words, mask.words, row_words * height);
 }
 
 
 SelectionMask::~SelectionMask() {
-    if (mask) delete[] mask;
+    if (words) delete[] words;
+}
+
+
+void SelectionMask::clearPadding() {
+    if (width % WORD_BITS == 0) return;
+
+    uint64_t tail = (uint64_t(1) << (width % WORD_BITS)) - 1;
+
+    for (size_t y = 0; y < height; y++)
+        words[y * row_words + row_words - 1] &= tail;
+}
+
+
+// ============================================================================
+
+
+template <MaskOperation OPERATION>
+static void combineWords(uint64_t *dst, const uint64_t *src, size_t count) {
+    size_t done = 0;
+
+#ifdef SIMD_KERNELS
+    if (hasAVX2()) done = combineWordsAVX2<OPERATION>(dst, src, count);
+    done += combineWordsSSE2<OPERATION>(dst + done, src + done, count - done);
+#endif
+
+    for (size_t i = done; i < count; i++)
+        dst[i] = combineWord<OPERATION>(dst[i], src[i]);
+}
+
+
+template <MaskOperation OPERATION>
+static uint64_t combineWord(uint64_t dst, uint64_t src) {
+    switch (OPERATION) {
+        case MaskOperation::UNITE:      return dst | src;
+        case MaskOperation::INTERSECT:  return dst & src;
+        case MaskOperation::SUBTRACT:   return dst & ~src;
+        case MaskOperation::INVERT:     return ~dst;
+        default:                        return dst;
+    }
+}
+
+
+#ifdef SIMD_KERNELS
+
+template <MaskOperation OPERATION>
+static size_t combineWordsSSE2(uint64_t *dst, const uint64_t *src, size_t count) {
+    const __m128i full = _mm_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        // OPERATION IS KNOWN AT COMPILE TIME, SO ONLY ONE BRANCH IS LEFT IN THE LOOP
+        switch (OPERATION) {
+            case MaskOperation::UNITE:      a = _mm_or_si128(a, b);     break;
+            case MaskOperation::INTERSECT:  a = _mm_and_si128(a, b);    break;
+            case MaskOperation::SUBTRACT:   a = _mm_andnot_si128(b, a); break;
+            case MaskOperation::INVERT:     a = _mm_xor_si128(a, full); break;
+            default:                                                    break;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), a);
+    }
+
+    return i;
+}
+
+
+template <MaskOperation OPERATION>
+AVX2_KERNEL static size_t combineWordsAVX2(uint64_t *dst, const uint64_t *src, size_t count) {
+    const __m256i full = _mm256_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+        switch (OPERATION) {
+            case MaskOperation::UNITE:      a = _mm256_or_si256(a, b);      break;
+            case MaskOperation::INTERSECT:  a = _mm256_and_si256(a, b);     break;
+            case MaskOperation::SUBTRACT:   a = _mm256_andnot_si256(b, a);  break;
+            case MaskOperation::INVERT:     a = _mm256_xor_si256(a, full);  break;
+            default:                                                        break;
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), a);
+    }
+
+    return i;
 }
+
+#endif
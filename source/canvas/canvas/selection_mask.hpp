@@ -8,15 +8,17 @@
 #define _SELECTION_MASK_H_
 
 
+#include <cstddef>
+#include <cstdint>
 #include "standart/Canvas/SelectionMask.h"
 
 
+/**
+ * \brief Selection mask that stores one bit per pixel
+ * \note Every row starts with new 64-bit word, bits after row end are always zero
+ * \note Invert and combining of masks process whole words with SSE2 or AVX2 instructions
+*/
 class SelectionMask : public plug::SelectionMask {
-private:
-    bool *mask;
-    size_t width;
-    size_t height;
-
 public:
     SelectionMask(size_t width_, size_t height_);
 
@@ -31,12 +33,52 @@ public:
     virtual bool getPixel(size_t x, size_t y) const override;
 
     virtual void setPixel(size_t x, size_t y, bool flag) override;
-    
+
+    /**
+     * \brief Sets all bits at once with memset
+    */
     virtual void fill(bool value) override;
-    
+
+    /**
+     * \brief Inverts mask by whole words
+    */
     virtual void invert() override;
 
+    /**
+     * \brief Finds run by skipping whole zero and whole one words
+    */
+    virtual bool findRun(size_t x, size_t y, size_t &begin, size_t &end) const override;
+
+    /**
+     * \brief Selects pixels that are selected in other mask
+     * \warning Masks must have the same size
+    */
+    void unite(const SelectionMask &mask);
+
+    /**
+     * \brief Deselects pixels that are not selected in other mask
+     * \warning Masks must have the same size
+    */
+    void intersect(const SelectionMask &mask);
+
+    /**
+     * \brief Deselects pixels that are selected in other mask
+     * \warning Masks must have the same size
+    */
+    void subtract(const SelectionMask &mask);
+
     virtual ~SelectionMask() override;
+
+private:
+    /**
+     * \brief Clears bits after row end in the last word of every row
+    */
+    void clearPadding();
+
+    uint64_t *words;        ///< Mask bits by rows, bit i of word is pixel 64 * word + i
+    size_t width;           ///< Width in pixels
+    size_t height;          ///< Height in pixels
+    size_t row_words;       ///< Amount of words in one row
 };
 
 
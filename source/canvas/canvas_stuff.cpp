@@ -8,6 +8,17 @@
 #include "canvas/palettes/palette_manager.hpp"
 
 
+/**
+ * \brief Puts canvas view into new subwindow with scrollbars
+*/
+Widget *createCanvasWindow(
+    CanvasView *canvas,
+    const char *title,
+    WindowStyle &window_style,
+    ScrollBarStyle &scrollbar_style
+);
+
+
 // ============================================================================
 
 
@@ -40,12 +51,44 @@ Widget *openPicture(
         }
     }
     // If canvas is correct we can create other stuff
+    return createCanvasWindow(canvas, (filename) ? filename : "Canvas", window_style, scrollbar_style);
+}
+
+
+Widget *openCanvasView(
+    CanvasView &canvas,
+    WindowStyle &window_style,
+    ScrollBarStyle &scrollbar_style
+) {
+    CanvasView *view = new CanvasView(
+        Widget::AUTO_ID,
+        AnchorLayoutBox(
+            plug::Vec2d(),
+            plug::Vec2d(SCREEN_W - 30, SCREEN_H - 30),
+            plug::Vec2d(),
+            plug::Vec2d(SCREEN_W - 30, SCREEN_H - 30)
+        ),
+        canvas.getDocument()
+    );
+
+    const char *filename = canvas.getFilename();
+    return createCanvasWindow(view, (filename) ? filename : "Canvas", window_style, scrollbar_style);
+}
+
+
+Widget *createCanvasWindow(
+    CanvasView *canvas,
+    const char *title,
+    WindowStyle &window_style,
+    ScrollBarStyle &scrollbar_style
+) {
     Window *subwindow = new Window(
         Widget::AUTO_ID,
         BoundLayoutBox(plug::Vec2d(300, 100), plug::Vec2d(800, 600)),
-        (filename) ? filename : "Canvas",
+        title,
         window_style
     );
+    subwindow->setLayered(true);
 
     subwindow->addChild(canvas);
     
@@ -201,6 +244,33 @@ OpenFileAction *OpenFileAction::clone() {
 // ============================================================================
 
 
+NewViewAction::NewViewAction(
+    Window &window_,
+    WindowStyle &window_style_,
+    ScrollBarStyle &scrollbar_style_
+) :
+    window(window_),
+    window_style(window_style_),
+    scrollbar_style(scrollbar_style_)
+{}
+
+
+void NewViewAction::operator () () {
+    CanvasView *canvas = CANVAS_GROUP.getActive();
+    if (!canvas) return;
+
+    window.addChild(openCanvasView(*canvas, window_style, scrollbar_style));
+}
+
+
+NewViewAction *NewViewAction::clone() {
+    return new NewViewAction(window, window_style, scrollbar_style);
+}
+
+
+// ============================================================================
+
+
 SaveAsFileAction::SaveAsFileAction() {}
 
 
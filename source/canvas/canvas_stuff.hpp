@@ -24,6 +24,17 @@ Widget *openPicture(
 );
 
 
+/**
+ * \brief Shows canvas document in new subwindow with scrollbars
+ * \note New view shares document with canvas, so no image data is copied
+*/
+Widget *openCanvasView(
+    CanvasView &canvas,
+    WindowStyle &window_style,
+    ScrollBarStyle &scrollbar_style
+);
+
+
 /// Moves canvas texture in vertical direction
 class VScrollCanvas : public ScrollAction {
 protected:
@@ -93,6 +104,26 @@ private:
 };
 
 
+/// Uses openCanvasView() to show active canvas document in one more window
+class NewViewAction : public ButtonAction {
+public:
+    NewViewAction(
+        Window &window_,
+        WindowStyle &window_style_,
+        ScrollBarStyle &scrollbar_style_
+    );
+
+    virtual void operator () () override;
+
+    virtual NewViewAction *clone() override;
+
+private:
+    Window &window;
+    WindowStyle &window_style;
+    ScrollBarStyle &scrollbar_style;
+};
+
+
 /// Saves active canvas texture to image
 class SaveAsFileAction : public DialogAction {
 public:
@@ -5,81 +5,70 @@
 
 
 #include "canvas/canvas_view.hpp"
+#include "widget/overlay.hpp"
 #include "canvas/palettes/palette_manager.hpp"
 
 
+/**
+ * \brief Makes triangle fan draw texture region on rectangle of the same size
+*/
+static void setRectangle(
+    plug::VertexArray &array,
+    const plug::Vec2d &position, const plug::Vec2d &size, const plug::Vec2d &tex_position
+);
+
+
 // ============================================================================
 
 
 CanvasView::CanvasView(size_t id_, const plug::LayoutBox &layout_) :
     Widget(id_, layout_),
-    canvas(),
+    document(new CanvasDocument()),
+    canvas(document->getCanvas()),
     texture_offset(plug::Vec2d(0, 0)),
-    filename("")
+    canvas_revision(0)
 {
+    ASSERT(document, "Failed to allocate document!\n");
     CANVAS_GROUP.addCanvas(this);
 }
 
 
-bool CanvasView::createImage(size_t width, size_t height) {
-    canvas.setSize(plug::Vec2d(width, height));
-    filename = "";
-    texture_offset = plug::Vec2d();
+CanvasView::CanvasView(size_t id_, const plug::LayoutBox &layout_, CanvasDocument &document_) :
+    Widget(id_, layout_),
+    document(&document_),
+    canvas(document_.getCanvas()),
+    texture_offset(plug::Vec2d(0, 0)),
+    canvas_revision(canvas.getRevision())
+{
+    document->addReference();
+    CANVAS_GROUP.addCanvas(this);
+}
 
-    plug::Texture texture(width, height);
-    for (size_t i = 0; i < width * height; i++)
-        texture.data[i] = COLOR_PALETTE.getBGColor();
-    
-    TextureShape(texture).draw(canvas, plug::Vec2d(), canvas.getSize());
 
-    return true;
+bool CanvasView::createImage(size_t width, size_t height) {
+    texture_offset = plug::Vec2d();
+    return document->createImage(width, height);
 }
 
 
 bool CanvasView::openImage(const char *filename_) {
-    sf::Image image;
-    if (image.loadFromFile(filename_)) {
-        createImage(image.getSize().x, image.getSize().y);
-
-        const uint8_t *src = image.getPixelsPtr();
-
-        plug::Texture texture(image.getSize().x, image.getSize().y);
-        
-        for (size_t i = 0; i < texture.width * texture.height; i++)
-            texture.data[i] = plug::Color(src[i * 4], src[i * 4 + 1], src[i * 4 + 2], src[i * 4 + 3]);
+    if (!document->openImage(filename_)) return false;
 
-        TextureShape(texture).draw(canvas, plug::Vec2d(), getPlugVector(image.getSize()));
-
-        filename = filename_;
-        return true;
-    }
-
-    return false;
+    texture_offset = plug::Vec2d();
+    return true;
 }
 
 
-void CanvasView::saveImage() {
-    ASSERT(isImageOpen(), "File was not specified!\n");
-    saveImageAs(filename.data());
-}
+void CanvasView::saveImage() { document->saveImage(); }
 
 
-void CanvasView::saveImageAs(const char *filename_) {
-    sf::Image image;
-    image.create(canvas.getSize().x, canvas.getSize().y, reinterpret_cast<const uint8_t*>(canvas.getTexture().data));
-    image.saveToFile(filename_);
-    filename = filename_;
-}
+void CanvasView::saveImageAs(const char *filename_) { document->saveImageAs(filename_); }
 
 
-const char *CanvasView::getFilename() const {
-    return (isImageOpen()) ? filename.data() : nullptr;
-}
+const char *CanvasView::getFilename() const { return document->getFilename(); }
 
 
-bool CanvasView::isImageOpen() const {
-    return filename.length() > 0;
-}
+bool CanvasView::isImageOpen() const { return document->isImageOpen(); }
 
 
 plug::Vec2d CanvasView::getTextureSize() const {
@@ -92,6 +81,9 @@ plug::Canvas &CanvasView::getCanvas() {
 }
 
 
+CanvasDocument &CanvasView::getDocument() { return *document; }
+
+
 bool CanvasView::isActive() const {
     return (this == CANVAS_GROUP.getActive());
 }
@@ -102,6 +94,18 @@ const plug::Vec2d &CanvasView::getTextureOffset() const { return texture_offset;
 
 void CanvasView::setTextureOffset(const plug::Vec2d &texture_offset_) {
     texture_offset = texture_offset_;
+    invalidate();
+}
+
+
+bool CanvasView::hasToolPreview() {
+    return isActive() && TOOL_PALETTE.getCurrentTool()->getWidget();
+}
+
+
+bool CanvasView::isOpaque() const {
+    plug::Vec2d size = canvas.getSize();
+    return size.x >= layout->getSize().x && size.y >= layout->getSize().y;
 }
 
 
@@ -109,23 +113,62 @@ void CanvasView::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
     plug::Vec2d global_position = stack.apply(layout->getPosition());
     plug::Vec2d global_size = applySize(stack, layout->getSize());
 
-    plug::Vec2d size = canvas.getSize();
-    if (size.x > global_size.x) size.x = global_size.x;
-    if (size.y > global_size.y) size.y = global_size.y;
+    // CANVAS AND TOOL PREVIEW ARE CUT BY VIEW BORDERS
+    ClipApplier clip(result, Rect(global_position, global_size));
+
+    // PART OF THE CANVAS BEFORE TEXTURE OFFSET IS SCROLLED OUT OF THE VIEW
+    Rect visible = intersect(Rect(texture_offset, global_size), Rect(plug::Vec2d(), canvas.getSize()));
 
     plug::VertexArray array(plug::TriangleFan, 4);
 
-    array[0] = plug::Vertex(plug::Vec2d(global_position), plug::Color(), plug::Vec2d(texture_offset));
-    array[1] = plug::Vertex(plug::Vec2d(global_position.x, global_position.y + size.y), plug::Color(), plug::Vec2d(texture_offset.x, texture_offset.y + size.y));
-    array[2] = plug::Vertex(plug::Vec2d(global_position + size), plug::Color(), texture_offset + size);
-    array[3] = plug::Vertex(plug::Vec2d(global_position.x + size.x, global_position.y), plug::Color(), plug::Vec2d(texture_offset.x + size.x, texture_offset.y));
+    // GPU COPY OF CANVAS IS UPDATED ONLY IN CHANGED TILES, SO IT IS USED DIRECTLY IF POSSIBLE
+    SFMLTextureTarget *sfml_target = dynamic_cast<SFMLTextureTarget*>(&result);
 
-    result.draw(array, canvas.getTexture());
+    if (sfml_target) {
+        // ONLY CELLS UNDER THE VIEW ARE UPLOADED AND DRAWN
+        for (size_t i = 0; i < canvas.getCellCount(); i++) {
+            Rect cell = canvas.getCellRect(i);
+            Rect part = intersect(cell, visible);
+            if (part.isEmpty()) continue;
 
-    if (isActive() && TOOL_PALETTE.getCurrentTool()->getWidget()) {
-        TransformApplier canvas_transform(stack, getTransform());
-        TransformApplier texture_transform(stack, plug::Transform(texture_offset * -1));
-        TOOL_PALETTE.getCurrentTool()->getWidget()->draw(stack, result);
+            setRectangle(array, global_position + part.position - texture_offset, part.size, part.position - cell.position);
+            sfml_target->draw(array, canvas.getCellTexture(i));
+        }
+    }
+    else if (!visible.isEmpty()) {
+        setRectangle(array, global_position + visible.position - texture_offset, visible.size, visible.position);
+        result.draw(array, canvas.getTexture());
+    }
+
+    if (!hasToolPreview()) return;
+
+    // PREVIEW GOES TO OVERLAY UNLESS IT WOULD COVER SOMETHING PLACED OVER THE VIEW
+    if (!isOccluded(getGlobalRect())) {
+        OVERLAY.setOwner(*this);
+        return;
+    }
+
+    OVERLAY.release(*this);
+    drawToolPreview(stack, result);
+}
+
+
+void CanvasView::drawOverlay(plug::TransformStack &stack, plug::RenderTarget &result) {
+    if (hasToolPreview()) drawToolPreview(stack, result);
+}
+
+
+void CanvasView::drawToolPreview(plug::TransformStack &stack, plug::RenderTarget &result) {
+    TransformApplier canvas_transform(stack, getTransform());
+    TransformApplier texture_transform(stack, plug::Transform(texture_offset * -1));
+    TOOL_PALETTE.getCurrentTool()->getWidget()->draw(stack, result);
+}
+
+
+void CanvasView::checkCanvasRevision() {
+    if (canvas_revision != canvas.getRevision()) {
+        canvas_revision = canvas.getRevision();
+        invalidate();
     }
 }
 
@@ -133,13 +176,29 @@ void CanvasView::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
 void CanvasView::onEvent(const plug::Event &event, plug::EHC &ehc) {
     if (ehc.overlapped) return;
 
+    bool had_preview = hasToolPreview();
+
     Widget::onEvent(event, ehc);
 
-    if (isActive() && TOOL_PALETTE.getCurrentTool()->getWidget()) {
+    if (hasToolPreview()) {
         TransformApplier canvas_transform(ehc.stack, getTransform());
         TransformApplier texture_transform(ehc.stack, plug::Transform(texture_offset * -1));
         TOOL_PALETTE.getCurrentTool()->getWidget()->onEvent(event, ehc);
     }
+
+    // PREVIEW CHANGES ONLY ON INPUT, SO IDLE TICKS DO NOT KEEP MAIN LOOP AWAKE
+    if (event.getType() == plug::Tick) return;
+
+    if (!had_preview && !hasToolPreview()) return;
+
+    // PREVIEW IN OVERLAY IS REDRAWN WITHOUT THE SCENE UNDER IT
+    if (OVERLAY.isOwner(*this))
+        OVERLAY.damage();
+    else
+        invalidate();
+
+    // PREVIEW MUST BE ERASED AFTER TOOL FINISHES DRAWING
+    if (!hasToolPreview()) OVERLAY.release(*this);
 }
 
 
@@ -225,6 +284,7 @@ void CanvasView::onKeyboardReleased(const plug::KeyboardReleasedEvent &event, pl
 
 CanvasView::~CanvasView() {
     CANVAS_GROUP.removeCanvas(this);
+    document->release();
 }
 
 
@@ -245,6 +305,10 @@ CanvasGroup::CanvasGroup() : canvases(), active(0) {}
 void CanvasGroup::setActive(CanvasView *new_active) {
     size_t index = getIndex(new_active);
     if (index < canvases.size()) {
+        // TOOL PREVIEW MOVES TO NEW ACTIVE CANVAS
+        if (active < canvases.size()) canvases[active]->invalidate();
+        new_active->invalidate();
+
         active = index;
         TOOL_PALETTE.setActiveCanvas(new_active->getCanvas());
     }
@@ -290,7 +354,28 @@ bool CanvasGroup::isInGroup(CanvasView *canvas) const {
 }
 
 
+void CanvasGroup::checkRevisions() {
+    // DOCUMENT CAN BE CHANGED BY TOOLS, FILTERS AND PLUGINS THROUGH ANY VIEW OR NONE AT ALL
+    for (size_t i = 0; i < canvases.size(); i++)
+        canvases[i]->checkCanvasRevision();
+}
+
+
 CanvasGroup &CanvasGroup::getInstance() {
     static CanvasGroup canvas_group;
     return canvas_group;
 }
+
+
+// ============================================================================
+
+
+static void setRectangle(
+    plug::VertexArray &array,
+    const plug::Vec2d &position, const plug::Vec2d &size, const plug::Vec2d &tex_position
+) {
+    array[0] = plug::Vertex(position, plug::Color(), tex_position);
+    array[1] = plug::Vertex(position + plug::Vec2d(0, size.y), plug::Color(), tex_position + plug::Vec2d(0, size.y));
+    array[2] = plug::Vertex(position + size, plug::Color(), tex_position + size);
+    array[3] = plug::Vertex(position + plug::Vec2d(size.x, 0), plug::Color(), tex_position + plug::Vec2d(size.x, 0));
+}
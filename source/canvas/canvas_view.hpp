@@ -8,7 +8,7 @@
 #define _CANVAS_VIEW_H_
 
 
-#include "canvas/canvas.hpp"
+#include "canvas/canvas/canvas_document.hpp"
 #include "widget/widget.hpp"
 
 
@@ -16,16 +16,23 @@
 class CanvasView : public Widget {
 public:
     /**
-     * \brief Creates empty canvas
+     * \brief Creates view with new empty document
     */
     CanvasView(size_t id_, const plug::LayoutBox &layout_);
 
-    CanvasView(const CanvasView &canvas) = default;
+    /**
+     * \brief Creates one more view of existing document
+     * \note Edits made through any view are visible in all views of the document
+    */
+    CanvasView(size_t id_, const plug::LayoutBox &layout_, CanvasDocument &document_);
+
+    CanvasView(const CanvasView &canvas) = delete;
 
-    CanvasView &operator = (const CanvasView &canvas) = default;
+    CanvasView &operator = (const CanvasView &canvas) = delete;
 
     /**
      * \brief Creates image with the given size filled with background color
+     * \note Image is replaced in all views of the document
     */
     bool createImage(size_t width, size_t height);
 
@@ -36,13 +43,13 @@ public:
     bool openImage(const char *filename_);
 
     /**
-     * \brief Saves texture to current image file
+     * \brief Saves canvas to current image file
      * \warning Assert will be called if image is not open
     */
     void saveImage();
 
     /**
-     * \brief Saves texture to path
+     * \brief Saves canvas to path
      * \note Changes filename field to filename_
     */
     void saveImageAs(const char *filename_);
@@ -68,6 +75,11 @@ public:
     */
     plug::Canvas &getCanvas();
 
+    /**
+     * \brief Returns document shown by this view
+    */
+    CanvasDocument &getDocument();
+
     /**
      * \brief Returns true if canvas is active in his group
     */
@@ -83,22 +95,48 @@ public:
     */
     void setTextureOffset(const plug::Vec2d &texture_offset_);
 
+    /**
+     * \brief Returns true if canvas is big enough to fill the whole view
+    */
+    virtual bool isOpaque() const override;
+
     /**
      * \brief Draws canvas inner texture
     */
     virtual void draw(plug::TransformStack &stack, plug::RenderTarget &result) override;
 
+    /**
+     * \brief Draws tool preview over the cached scene
+    */
+    virtual void drawOverlay(plug::TransformStack &stack, plug::RenderTarget &result) override;
+
     /**
      * \brief Broadcast events to tool widget
+     * \note Damages overlay or widget region if tool preview has changed
     */
     virtual void onEvent(const plug::Event &event, plug::EHC &ehc) override;
 
     /**
-     * \brief Removes canvas from his group
+     * \brief Damages widget region if canvas was modified since the last check
+    */
+    void checkCanvasRevision();
+
+    /**
+     * \brief Removes canvas from his group and releases document
     */
     virtual ~CanvasView() override;
 
 protected:
+    /**
+     * \brief Returns true if current tool draws its preview on this view
+    */
+    bool hasToolPreview();
+
+    /**
+     * \brief Draws current tool widget in canvas coordinates
+    */
+    void drawToolPreview(plug::TransformStack &stack, plug::RenderTarget &result);
+
     virtual void onMouseMove(const plug::MouseMoveEvent &event, plug::EHC &ehc) override;
     
     virtual void onMousePressed(const plug::MousePressedEvent &event, plug::EHC &ehc) override;
@@ -109,9 +147,10 @@ protected:
     
     virtual void onKeyboardReleased(const plug::KeyboardReleasedEvent &event, plug::EHC &ehc) override;
 
-    SFMLCanvas canvas;
+    CanvasDocument *document;   ///< Shared image that is shown
+    SFMLCanvas &canvas;         ///< Canvas of the document
     plug::Vec2d texture_offset;
-    std::string filename;
+    size_t canvas_revision;     ///< Canvas revision that was drawn last time
 };
 
 
@@ -146,6 +185,12 @@ public:
     */
     bool isInGroup(CanvasView *canvas) const;
 
+    /**
+     * \brief Damages every canvas which document was modified since it was drawn
+     * \note Call this method once per frame before drawing, so views of the same document never show different images
+    */
+    void checkRevisions();
+
     /**
      * \brief Returns single instance of CanvasGroup
     */
@@ -136,6 +136,7 @@ void IntensityCurve::onMouseMove(const plug::MouseMoveEvent &event, plug::EHC &e
         new_point.y = 255 - new_point.y;
 
         filter.setPointHeight(moving_point, new_point.y);
+        invalidate();
     }
 
     if (isInsideRect(global_position, global_size, event.pos))
@@ -151,6 +152,7 @@ void IntensityCurve::onMousePressed(const plug::MousePressedEvent &event, plug::
         plug::Vec2d new_point = event.pos - global_position;
 
         moving_point = filter.addPoint(new_point.x);
+        invalidate();
         
         ehc.stopped = true;
     }
@@ -260,24 +262,13 @@ IntensityCurveFilter::IntensityCurveFilter(const WindowStyle &style_) :
 
 
 void IntensityCurveFilter::applyFilter(plug::Canvas &canvas) const {
-    plug::SelectionMask &mask = canvas.getSelectionMask();
-    plug::Texture texture(canvas.getTexture());
-    
-    for (size_t y = 0; y < mask.getHeight(); y++) {
-        for (size_t x = 0; x < mask.getWidth(); x++) {
-            if (mask.getPixel(x, y)) {
-                plug::Color origin(texture.getPixel(x, y));
-                
-                texture.setPixel(x, y, plug::Color(
-                    getIntensity(origin.r),
-                    getIntensity(origin.g),
-                    getIntensity(origin.b)
-                ));
-            }
-        }
-    }
-
-    TextureShape(texture).draw(canvas, plug::Vec2d(), canvas.getSize());
+    transformSelection(canvas, [this](const plug::Color &origin) {
+        return plug::Color(
+            getIntensity(origin.r),
+            getIntensity(origin.g),
+            getIntensity(origin.b)
+        );
+    });
 }
 
 
@@ -78,6 +78,9 @@ ColorPaletteView::ColorPaletteView(size_t id_, const plug::LayoutBox &layout_) :
 {
     buttons.setParent(this);
 
+    // BUTTON STATUS CHANGES INVALIDATE RECORDED DRAWS
+    setRetained(true);
+
     ADD_COLOR_BUTTON(Black, plug::Vec2d());
     ADD_COLOR_BUTTON(White, plug::Vec2d(94, 0));
     ADD_COLOR_BUTTON(Red,plug::Vec2d(0, 94));
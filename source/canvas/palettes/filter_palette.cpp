@@ -15,8 +15,8 @@
 FilterPalette::FilterPalette(WindowStyle &window_style) :
     filters(FILTERS_SIZE, nullptr), last_filter(0)
 {
-    filters[LIGHTEN_FILTER] = new IntensityFilter(20);
-    filters[DARKEN_FILTER] = new IntensityFilter(-20);
+    filters[LIGHTEN_FILTER] = new IntensityFilter(FILTER_INTENSITY);
+    filters[DARKEN_FILTER] = new IntensityFilter(-FILTER_INTENSITY);
     filters[MONOCHROME_FILTER] = new MonochromeFilter();
     filters[NEGATIVE_FILTER] = new NegativeFilter();
     filters[INTENSITY_CURVE] = new IntensityCurveFilter(window_style);
@@ -10,6 +10,7 @@
 #include "window/window.hpp"
 #include "canvas/palettes/palette_manager.hpp"
 #include "canvas/canvas_view.hpp"
+#include "widget/texture_cache.hpp"
 
 
 // ============================================================================
@@ -149,6 +150,9 @@ ToolPaletteView::ToolPaletteView(
 {
     buttons.setParent(this);
 
+    // BUTTON STATUS CHANGES INVALIDATE RECORDED DRAWS
+    setRetained(true);
+
     group = new ButtonGroup();
 
     ADD_TOOL_BUTTON(ToolPalette::PENCIL_TOOL,   PaletteViewAsset::PENCIL_TEXTURE,   plug::Vec2d());
@@ -179,6 +183,10 @@ void ToolPaletteView::draw(plug::TransformStack &stack, plug::RenderTarget &resu
 
 
 void ToolPaletteView::onEvent(const plug::Event &event, plug::EHC &ehc) {
+    // TOOL CAN BE CHANGED FROM OUTSIDE SO BUTTONS ARE SYNCED BEFORE DRAW IS REQUIRED
+    updateButtons();
+    updateCurrentButton();
+
     Widget::onEvent(event, ehc);
     if (ehc.stopped) return;
 
@@ -289,6 +297,8 @@ void ToolPaletteView::addTool(size_t tool_id) {
         icons.push_back(new_icon);
     }
 
+    TEXTURE_CACHE.retain(*new_icon);
+
     Widget *prev_button = buttons.findWidget(Widget::AUTO_ID + tool_id);
 
     plug::Vec2d position = prev_button->getLayoutBox().getPosition();
@@ -326,6 +336,7 @@ ToolPaletteView::~ToolPaletteView() {
     // Delete icons for additional tools
     for (size_t i = 0; i < icons.size(); i++) {
         ASSERT(icons[i], "Icon is nullptr!\n");
+        TEXTURE_CACHE.release(*icons[i]);
         delete icons[i];
     }
 }
@@ -83,4 +83,27 @@ protected:
 };
 
 
+/**
+ * \brief Replaces every selected canvas pixel with function result
+ * \note Canvas is read and written by runs of selected pixels, so only one row is copied at a time
+*/
+template <typename Function>
+void transformSelection(plug::Canvas &canvas, Function function) {
+    plug::SelectionMask &mask = canvas.getSelectionMask();
+
+    plug::Texture row(mask.getWidth(), 1);
+
+    for (size_t y = 0; y < mask.getHeight(); y++) {
+        for (size_t begin = 0, end = 0; mask.findRun(end, y, begin, end);) {
+            canvas.copyPixels(begin, y, end - begin, 1, row.data);
+
+            for (size_t x = 0; x < end - begin; x++)
+                row.data[x] = function(row.data[x]);
+
+            canvas.setPixels(begin, y, end - begin, 1, row.data);
+        }
+    }
+}
+
+
 #endif
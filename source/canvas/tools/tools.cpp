@@ -13,7 +13,6 @@
 
 const plug::Color PREVIEW_COLOR = Blue;                       ///< Standart color for all previews
 const float RECT_PREVIEW_OUTLINE = 1;                   ///< Rect preview outline thickness
-const int ERASER_STEP = 100;                            ///< Amount of spheres that drawn between two points
 const float ERASER_RADIUS = 25;                         ///< Eraser sphere radius
 const float POLYGON_EPSILON = 25;                       ///< Maximal distance for points of polygon to form it
 const unsigned TEXT_SIZE = 20;                          ///< Text tool font size
@@ -295,17 +294,9 @@ void EraserTool::onMainButton(const plug::ControlState &state, const plug::Vec2d
 
 void EraserTool::onMove(const plug::Vec2d &mouse) {
     if (is_drawing) {
-        plug::Vec2d step(
-            (mouse.x - prev_position.x) / ERASER_STEP, 
-            (mouse.y - prev_position.y) / ERASER_STEP
-        );
-
-        CircleShape circle(mouse, ERASER_RADIUS, color_palette->getBGColor());
-
-        for (int i = 0; i < ERASER_STEP; i++) {
-            circle.draw(*canvas);
-            circle.setPosition(circle.getPosition() + step);
-        }
+        // ONE MESH PER SEGMENT, CANVAS MERGES SEGMENTS OF ONE FRAME INTO ONE DRAW CALL
+        CapsuleShape capsule(prev_position, mouse, ERASER_RADIUS, color_palette->getBGColor());
+        capsule.draw(*canvas);
 
         prev_position = mouse;
     }
@@ -325,42 +316,47 @@ void ColorPicker::onMainButton(const plug::ControlState &state, const plug::Vec2
 
 
 void BucketTool::onMainButton(const plug::ControlState &state, const plug::Vec2d &mouse) {
-    if (state.state == plug::State::Pressed) {
-        plug::Color color = color_palette->getFGColor();
-        plug::Color origin = canvas->getPixel(mouse.x, mouse.y);
+    if (state.state != plug::State::Pressed) return;
 
-        plug::Texture texture(canvas->getTexture());
-        
-        List<sf::Vector2u> dfs;
-        dfs.push_back(sf::Vector2u(mouse.x, mouse.y));
-        texture.setPixel(dfs.back().x, dfs.back().y, color);
-        
-        while (dfs.size()) {
-            sf::Vector2u pixel = dfs.back();
-            dfs.pop_back();
+    plug::Vec2d size = canvas->getSize();
+    if (mouse.x < 0 || mouse.y < 0 || mouse.x >= size.x || mouse.y >= size.y) return;
 
-            if (pixel.x > 0 && isEqual(texture.getPixel(pixel.x - 1, pixel.y), origin)) {
-                dfs.push_back(sf::Vector2u(pixel.x - 1, pixel.y));
-                texture.setPixel(pixel.x - 1, pixel.y, color);
-            }
+    plug::Color color = color_palette->getFGColor();
+    plug::Color origin = canvas->getPixel(mouse.x, mouse.y);
 
-            if (pixel.x < texture.width - 1 && isEqual(texture.getPixel(pixel.x + 1, pixel.y), origin)) {
-                dfs.push_back(sf::Vector2u(pixel.x + 1, pixel.y));
-                texture.setPixel(pixel.x + 1, pixel.y, color);
-            }
+    // FILLED PIXELS MUST DIFFER FROM ORIGIN, OTHERWISE THEY ARE VISITED AGAIN
+    if (isEqual(color, origin)) return;
 
-            if (pixel.y > 0 && isEqual(texture.getPixel(pixel.x, pixel.y - 1), origin)) {
-                dfs.push_back(sf::Vector2u(pixel.x, pixel.y - 1));
-                texture.setPixel(pixel.x, pixel.y - 1, color);
-            }
+    // EVERY SEED FILLS THE WHOLE ROW SPAN OF ORIGIN COLOR AROUND IT
+    List<sf::Vector2u> seeds;
+    seeds.push_back(sf::Vector2u(mouse.x, mouse.y));
+
+    while (seeds.size()) {
+        sf::Vector2u seed = seeds.back();
+        seeds.pop_back();
+
+        if (!isEqual(canvas->getPixel(seed.x, seed.y), origin)) continue;
+
+        size_t left = seed.x, right = seed.x + 1;
+        while (left > 0 && isEqual(canvas->getPixel(left - 1, seed.y), origin)) left--;
+        while (right < size.x && isEqual(canvas->getPixel(right, seed.y), origin)) right++;
+
+        canvas->fillSpan(left, seed.y, right - left, color);
 
-            if (pixel.y < texture.height - 1 && isEqual(texture.getPixel(pixel.x, pixel.y + 1), origin)) {
-                dfs.push_back(sf::Vector2u(pixel.x, pixel.y + 1));
-                texture.setPixel(pixel.x, pixel.y + 1, color);
+        // ONE SEED FOR EVERY RUN OF ORIGIN COLOR IN NEIGHBOUR ROWS
+        for (int dy = -1; dy <= 1; dy += 2) {
+            if ((dy < 0 && seed.y == 0) || (dy > 0 && seed.y + 1 >= size.y)) continue;
+
+            size_t y = seed.y + dy;
+            bool is_run = false;
+
+            for (size_t x = left; x < right; x++) {
+                bool is_origin = isEqual(canvas->getPixel(x, y), origin);
+
+                if (is_origin && !is_run) seeds.push_back(sf::Vector2u(x, y));
+                is_run = is_origin;
             }
         }
-        
-        TextureShape(texture).draw(*canvas, plug::Vec2d(), canvas->getSize());
     }
 }
 
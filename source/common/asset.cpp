@@ -13,17 +13,19 @@
 const size_t MAX_PATH = 256;
 
 
-Asset::Asset() : textures() {}
+Asset::Asset() : atlas(nullptr) {}
 
 
-Asset::Asset(const Asset &arg) : textures(arg.textures.size(), nullptr) {
-    for (size_t i = 0; i < textures.size(); i++)
-        textures[i] = new plug::Texture(*arg.textures[i]);
+Asset::Asset(const Asset &arg) : atlas(nullptr) {
+    if (arg.atlas) {
+        atlas = new TextureAtlas(*arg.atlas);
+        ASSERT(atlas, "Failed to allocate atlas!\n");
+    }
 }
 
 
 void Asset::loadTextures(const char *rootpath, const char *files[], size_t files_size) {
-    textures.resize(files_size, nullptr);
+    List<plug::Texture*> textures(files_size, nullptr);
 
     char *path = (char *) calloc(strlen(rootpath) + MAX_PATH, 1);
     ASSERT(path, "Failed to allocate buffer!\n");
@@ -34,34 +36,43 @@ void Asset::loadTextures(const char *rootpath, const char *files[], size_t files
     }
 
     free(path);
+
+    if (atlas) delete atlas;
+
+    atlas = new TextureAtlas(textures);
+    ASSERT(atlas, "Failed to allocate atlas!\n");
+
+    // ATLAS HAS ITS OWN COPY OF TEXTURES
+    for (size_t i = 0; i < textures.size(); i++)
+        delete textures[i];
 }
 
 
 Asset &Asset::operator = (const Asset &arg) {
     if (this != &arg) {
-        for (size_t i = 0; i < textures.size(); i++)
-            delete textures[i];
-
-        textures.resize(arg.textures.size(), nullptr);
+        if (atlas) delete atlas;
+        atlas = nullptr;
 
-        for (size_t i = 0; i < textures.size(); i++)
-            textures[i] = arg.textures[i];
+        if (arg.atlas) {
+            atlas = new TextureAtlas(*arg.atlas);
+            ASSERT(atlas, "Failed to allocate atlas!\n");
+        }
     }
 
     return *this;
 }
 
 
-const plug::Texture &Asset::getTexture(int id) const {
-    ASSERT(0 <= id && size_t(id) < textures.size(), "Index is out of range!\n");
+const TextureRegion &Asset::getTexture(int id) const {
+    ASSERT(atlas, "Load textures first!\n");
+    ASSERT(0 <= id && size_t(id) < atlas->getRegionCount(), "Index is out of range!\n");
 
-    return *(textures[id]);
+    return atlas->getRegion(id);
 }
 
 
 Asset::~Asset() {
-    for (size_t i = 0; i < textures.size(); i++)
-        delete textures[i];
+    if (atlas) delete atlas;
 }
 
 
@@ -87,7 +98,7 @@ WindowAsset::WindowAsset(const char *rootpath) {
 }
 
 
-const plug::Texture &WindowAsset::operator [] (TEXTURE_ID id) const {
+const TextureRegion &WindowAsset::operator [] (TEXTURE_ID id) const {
     return getTexture(id);
 }
 
@@ -110,6 +121,6 @@ PaletteViewAsset::PaletteViewAsset(const char *rootpath) {
 }
 
 
-const plug::Texture &PaletteViewAsset::operator [] (TEXTURE_ID id) const {
+const TextureRegion &PaletteViewAsset::operator [] (TEXTURE_ID id) const {
     return getTexture(id);
 }
@@ -11,12 +11,13 @@
 #include <cstdio>
 #include "common/list.hpp"
 #include "widget/render_target.hpp"
+#include "widget/texture_atlas.hpp"
 
 
 /// Base class for all assets
 class Asset {
 protected:
-    List<plug::Texture*> textures;    ///< Textures array
+    TextureAtlas *atlas;    ///< All asset textures packed together
 
     /**
      * \brief Contructs empty asset
@@ -24,12 +25,12 @@ protected:
     Asset();
 
     /**
-     * \brief Init texture buffer and copies assets
+     * \brief Copies atlas
     */
     Asset(const Asset &arg);
 
     /**
-     * \brief Loads textures from files located in the rootpath directory
+     * \brief Loads textures from files located in the rootpath directory and packs them into atlas
     */
     void loadTextures(const char *rootpath, const char *files[], size_t assets_count);
 
@@ -39,12 +40,12 @@ protected:
     Asset &operator = (const Asset &arg);
 
     /**
-     * \brief Returns texture by its id
+     * \brief Returns texture region by its id
     */
-    const plug::Texture &getTexture(int id) const;
+    const TextureRegion &getTexture(int id) const;
 
     /**
-     * \brief Free textures
+     * \brief Free atlas
     */
     ~Asset();
 };
@@ -72,7 +73,7 @@ public:
 
     WindowAsset(const char *rootpath);
 
-    const plug::Texture &operator [] (TEXTURE_ID id) const;
+    const TextureRegion &operator [] (TEXTURE_ID id) const;
 };
 
 
@@ -94,7 +95,7 @@ public:
 
     PaletteViewAsset(const char *rootpath);
 
-    const plug::Texture &operator [] (TEXTURE_ID id) const;
+    const TextureRegion &operator [] (TEXTURE_ID id) const;
 };
 
 
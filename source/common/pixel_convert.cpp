@@ -0,0 +1,369 @@
+/**
+ * \file
+ * \brief Contains implementation of pixel format conversions
+*/
+
+
+#include <cstring>
+#include "common/pixel_convert.hpp"
+#include "common/simd.hpp"
+
+
+static_assert(sizeof(plug::Color) == 4, "plug::Color must be stored as 4 bytes!\n");
+
+
+/**
+ * \brief Swaps the first and the third byte of every pixel
+*/
+static void swapRedBlue(uint8_t *dst, const uint8_t *src, size_t count);
+
+
+#ifdef SIMD_KERNELS
+
+/**
+ * \brief Swaps red and blue channels of pixels by groups of 4
+ * \return Amount of processed pixels
+*/
+static size_t swapRedBlueSSE2(uint8_t *dst, const uint8_t *src, size_t count);
+
+
+/**
+ * \brief Swaps red and blue channels of pixels by groups of 8
+ * \return Amount of processed pixels
+*/
+AVX2_KERNEL static size_t swapRedBlueAVX2(uint8_t *dst, const uint8_t *src, size_t count);
+
+
+/**
+ * \brief Premultiplies pixels by groups of 4
+ * \return Amount of processed pixels
+*/
+static size_t premultiplyAlphaSSE2(uint8_t *dst, const uint8_t *src, size_t count);
+
+
+/**
+ * \brief Premultiplies pixels by groups of 8
+ * \return Amount of processed pixels
+*/
+AVX2_KERNEL static size_t premultiplyAlphaAVX2(uint8_t *dst, const uint8_t *src, size_t count);
+
+
+/**
+ * \brief Unpremultiplies pixels by groups of 4
+ * \return Amount of processed pixels
+*/
+static size_t unpremultiplyAlphaSSE2(uint8_t *dst, const uint8_t *src, size_t count);
+
+
+/**
+ * \brief Unpremultiplies pixels by groups of 8
+ * \return Amount of processed pixels
+*/
+AVX2_KERNEL static size_t unpremultiplyAlphaAVX2(uint8_t *dst, const uint8_t *src, size_t count);
+
+#endif
+
+
+// ============================================================================
+
+
+void convertRGBAToColors(plug::Color *dst, const uint8_t *src, size_t count) {
+    if (static_cast<const void*>(dst) != static_cast<const void*>(src))
+        memcpy(dst, src, count * sizeof(plug::Color));
+}
+
+
+void convertColorsToRGBA(uint8_t *dst, const plug::Color *src, size_t count) {
+    if (static_cast<const void*>(dst) != static_cast<const void*>(src))
+        memcpy(dst, src, count * sizeof(plug::Color));
+}
+
+
+void convertBGRAToColors(plug::Color *dst, const uint8_t *src, size_t count) {
+    swapRedBlue(reinterpret_cast<uint8_t*>(dst), src, count);
+}
+
+
+void convertColorsToBGRA(uint8_t *dst, const plug::Color *src, size_t count) {
+    swapRedBlue(dst, reinterpret_cast<const uint8_t*>(src), count);
+}
+
+
+void premultiplyAlpha(plug::Color *dst, const plug::Color *src, size_t count) {
+    size_t done = 0;
+
+#ifdef SIMD_KERNELS
+    uint8_t *dst_bytes = reinterpret_cast<uint8_t*>(dst);
+    const uint8_t *src_bytes = reinterpret_cast<const uint8_t*>(src);
+
+    if (hasAVX2()) done = premultiplyAlphaAVX2(dst_bytes, src_bytes, count);
+    done += premultiplyAlphaSSE2(dst_bytes + done * 4, src_bytes + done * 4, count - done);
+#endif
+
+    for (size_t i = done; i < count; i++) {
+        plug::Color color = src[i];
+
+        // ROUNDED DIVISION BY 255 WITHOUT DIVISION
+        unsigned red   = color.r * color.a + 128;
+        unsigned green = color.g * color.a + 128;
+        unsigned blue  = color.b * color.a + 128;
+
+        dst[i] = plug::Color(
+            (red   + (red   >> 8)) >> 8,
+            (green + (green >> 8)) >> 8,
+            (blue  + (blue  >> 8)) >> 8,
+            color.a
+        );
+    }
+}
+
+
+void unpremultiplyAlpha(plug::Color *dst, const plug::Color *src, size_t count) {
+    size_t done = 0;
+
+#ifdef SIMD_KERNELS
+    uint8_t *dst_bytes = reinterpret_cast<uint8_t*>(dst);
+    const uint8_t *src_bytes = reinterpret_cast<const uint8_t*>(src);
+
+    if (hasAVX2()) done = unpremultiplyAlphaAVX2(dst_bytes, src_bytes, count);
+    done += unpremultiplyAlphaSSE2(dst_bytes + done * 4, src_bytes + done * 4, count - done);
+#endif
+
+    for (size_t i = done; i < count; i++) {
+        plug::Color color = src[i];
+
+        if (!color.a) {
+            dst[i] = plug::Color(0, 0, 0, 0);
+            continue;
+        }
+
+        // ROUNDS HALF UP THE SAME WAY AS VECTOR KERNELS
+        unsigned red   = (color.r * 510u + color.a) / (color.a * 2u);
+        unsigned green = (color.g * 510u + color.a) / (color.a * 2u);
+        unsigned blue  = (color.b * 510u + color.a) / (color.a * 2u);
+
+        dst[i] = plug::Color(
+            (red   < 255) ? red   : 255,
+            (green < 255) ? green : 255,
+            (blue  < 255) ? blue  : 255,
+            color.a
+        );
+    }
+}
+
+
+// ============================================================================
+
+
+static void swapRedBlue(uint8_t *dst, const uint8_t *src, size_t count) {
+    size_t done = 0;
+
+#ifdef SIMD_KERNELS
+    if (hasAVX2()) done = swapRedBlueAVX2(dst, src, count);
+    done += swapRedBlueSSE2(dst + done * 4, src + done * 4, count - done);
+#endif
+
+    for (size_t i = done; i < count; i++) {
+        // PIXEL IS READ ENTIRELY BEFORE WRITE, SO CONVERSION CAN BE DONE IN PLACE
+        uint8_t first = src[i * 4], third = src[i * 4 + 2];
+
+        dst[i * 4]     = third;
+        dst[i * 4 + 1] = src[i * 4 + 1];
+        dst[i * 4 + 2] = first;
+        dst[i * 4 + 3] = src[i * 4 + 3];
+    }
+}
+
+
+#ifdef SIMD_KERNELS
+
+
+static size_t swapRedBlueSSE2(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m128i green_alpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i low_byte = _mm_set1_epi32(0xFF);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+
+        // PIXELS ARE LITTLE ENDIAN, SO THE FIRST BYTE IS THE LOWEST
+        __m128i result = _mm_or_si128(
+            _mm_and_si128(pixels, green_alpha),
+            _mm_or_si128(
+                _mm_slli_epi32(_mm_and_si128(pixels, low_byte), 16),
+                _mm_and_si128(_mm_srli_epi32(pixels, 16), low_byte)
+            )
+        );
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), result);
+    }
+
+    return i;
+}
+
+
+AVX2_KERNEL static size_t swapRedBlueAVX2(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m256i order = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(pixels, order));
+    }
+
+    return i;
+}
+
+
+static size_t premultiplyAlphaSSE2(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+
+    // ALPHA CHANNEL IS MULTIPLIED BY 255, SO IT STAYS THE SAME AFTER DIVISION
+    const __m128i alpha_lanes = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+
+        // EACH HALF HOLDS TWO PIXELS WITH 16 BIT CHANNELS
+        __m128i halves[2] = {_mm_unpacklo_epi8(pixels, zero), _mm_unpackhi_epi8(pixels, zero)};
+
+        for (size_t j = 0; j < 2; j++) {
+            __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(halves[j], 0xFF), 0xFF);
+            alpha = _mm_or_si128(alpha, alpha_lanes);
+
+            __m128i value = _mm_add_epi16(_mm_mullo_epi16(halves[j], alpha), round);
+            halves[j] = _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+    }
+
+    return i;
+}
+
+
+AVX2_KERNEL static size_t premultiplyAlphaAVX2(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i round = _mm256_set1_epi16(128);
+    const __m256i alpha_lanes = _mm256_setr_epi16(
+        0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255
+    );
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+
+        // UNPACK AND PACK WORK INSIDE 128 BIT LANES, SO PIXEL ORDER IS PRESERVED
+        __m256i halves[2] = {_mm256_unpacklo_epi8(pixels, zero), _mm256_unpackhi_epi8(pixels, zero)};
+
+        for (size_t j = 0; j < 2; j++) {
+            __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(halves[j], 0xFF), 0xFF);
+            alpha = _mm256_or_si256(alpha, alpha_lanes);
+
+            __m256i value = _mm256_add_epi16(_mm256_mullo_epi16(halves[j], alpha), round);
+            halves[j] = _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(halves[0], halves[1]));
+    }
+
+    return i;
+}
+
+
+static size_t unpremultiplyAlphaSSE2(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128 max_value = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+
+        __m128i low = _mm_unpacklo_epi8(pixels, zero);
+        __m128i high = _mm_unpackhi_epi8(pixels, zero);
+
+        // EACH VECTOR HOLDS ONE PIXEL WITH 32 BIT CHANNELS
+        __m128i channels[4] = {
+            _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+            _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)
+        };
+
+        for (size_t j = 0; j < 4; j++) {
+            __m128 alpha = _mm_cvtepi32_ps(_mm_shuffle_epi32(channels[j], 0xFF));
+            __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(channels[j]), max_value);
+
+            __m128 result = _mm_min_ps(_mm_add_ps(_mm_div_ps(value, alpha), half), max_value);
+
+            // TRANSPARENT PIXELS GIVE INF OR NAN, THEIR CHANNELS BECOME ZERO
+            result = _mm_andnot_ps(_mm_cmpeq_ps(alpha, _mm_setzero_ps()), result);
+
+            channels[j] = _mm_cvttps_epi32(result);
+        }
+
+        __m128i result = _mm_packus_epi16(
+            _mm_packs_epi32(channels[0], channels[1]),
+            _mm_packs_epi32(channels[2], channels[3])
+        );
+
+        // ALPHA IS TAKEN FROM SOURCE
+        result = _mm_or_si128(_mm_andnot_si128(alpha_mask, result), _mm_and_si128(pixels, alpha_mask));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), result);
+    }
+
+    return i;
+}
+
+
+AVX2_KERNEL static size_t unpremultiplyAlphaAVX2(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m256 max_value = _mm256_set1_ps(255.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+
+        // EACH VECTOR HOLDS TWO PIXELS, ONE IN EVERY 128 BIT LANE
+        __m256i channels[4] = {};
+        for (size_t j = 0; j < 4; j++) {
+            channels[j] = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (i + j * 2) * 4))
+            );
+
+            __m256 alpha = _mm256_cvtepi32_ps(_mm256_shuffle_epi32(channels[j], 0xFF));
+            __m256 value = _mm256_mul_ps(_mm256_cvtepi32_ps(channels[j]), max_value);
+
+            __m256 result = _mm256_min_ps(_mm256_add_ps(_mm256_div_ps(value, alpha), half), max_value);
+            result = _mm256_andnot_ps(_mm256_cmp_ps(alpha, _mm256_setzero_ps(), _CMP_EQ_OQ), result);
+
+            channels[j] = _mm256_cvttps_epi32(result);
+        }
+
+        // PACKING INSIDE LANES GIVES PIXELS 0 2 4 6 1 3 5 7
+        __m256i result = _mm256_packus_epi16(
+            _mm256_packs_epi32(channels[0], channels[1]),
+            _mm256_packs_epi32(channels[2], channels[3])
+        );
+        result = _mm256_permutevar8x32_epi32(result, order);
+
+        result = _mm256_or_si256(
+            _mm256_andnot_si256(alpha_mask, result), _mm256_and_si256(pixels, alpha_mask)
+        );
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), result);
+    }
+
+    return i;
+}
+
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * \file
+ * \brief Contains functions for converting pixel arrays between formats
+*/
+
+
+#ifndef _PIXEL_CONVERT_H_
+#define _PIXEL_CONVERT_H_
+
+
+#include <cstddef>
+#include <cstdint>
+#include "standart/Color.h"
+
+
+/**
+ * \brief Converts RGBA bytes (sf::Image layout) to colors
+ * \note plug::Color is stored as RGBA, so pixels are copied with memcpy
+*/
+void convertRGBAToColors(plug::Color *dst, const uint8_t *src, size_t count);
+
+
+/**
+ * \brief Converts colors to RGBA bytes (sf::Image layout)
+ * \note plug::Color is stored as RGBA, so pixels are copied with memcpy
+*/
+void convertColorsToRGBA(uint8_t *dst, const plug::Color *src, size_t count);
+
+
+/**
+ * \brief Converts BGRA bytes to colors
+ * \note dst and src can point to the same pixels
+*/
+void convertBGRAToColors(plug::Color *dst, const uint8_t *src, size_t count);
+
+
+/**
+ * \brief Converts colors to BGRA bytes
+ * \note dst and src can point to the same pixels
+*/
+void convertColorsToBGRA(uint8_t *dst, const plug::Color *src, size_t count);
+
+
+/**
+ * \brief Multiplies color channels by alpha rounding to nearest
+ * \note dst and src can point to the same pixels
+*/
+void premultiplyAlpha(plug::Color *dst, const plug::Color *src, size_t count);
+
+
+/**
+ * \brief Divides color channels by alpha rounding to nearest
+ * \note Channels of transparent pixels become zero, channels greater than alpha become 255
+ * \note dst and src can point to the same pixels
+*/
+void unpremultiplyAlpha(plug::Color *dst, const plug::Color *src, size_t count);
+
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * \file
+ * \brief Contains implementation of rectangle functions
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include "common/rect.hpp"
+#include "common/utils.hpp"
+
+
+// ============================================================================
+
+
+Rect::Rect() : position(), size() {}
+
+
+Rect::Rect(const plug::Vec2d &position_, const plug::Vec2d &size_) :
+    position(position_), size(size_) {}
+
+
+bool Rect::isEmpty() const { return size.x <= 0 || size.y <= 0; }
+
+
+bool Rect::contains(const Rect &rect) const {
+    if (rect.isEmpty()) return true;
+    if (isEmpty()) return false;
+
+    plug::Vec2d end = getEnd();
+    plug::Vec2d rect_end = rect.getEnd();
+
+    return  position.x <= rect.position.x && position.y <= rect.position.y &&
+            end.x >= rect_end.x && end.y >= rect_end.y;
+}
+
+
+plug::Vec2d Rect::getEnd() const { return position + size; }
+
+
+// ============================================================================
+
+
+Rect intersect(const Rect &a, const Rect &b) {
+    plug::Vec2d a_end = a.getEnd();
+    plug::Vec2d b_end = b.getEnd();
+
+    plug::Vec2d start(std::max(a.position.x, b.position.x), std::max(a.position.y, b.position.y));
+    plug::Vec2d end(std::min(a_end.x, b_end.x), std::min(a_end.y, b_end.y));
+
+    Rect result(start, end - start);
+    return (result.isEmpty()) ? Rect() : result;
+}
+
+
+Rect unite(const Rect &a, const Rect &b) {
+    if (a.isEmpty()) return b;
+    if (b.isEmpty()) return a;
+
+    plug::Vec2d a_end = a.getEnd();
+    plug::Vec2d b_end = b.getEnd();
+
+    plug::Vec2d start(std::min(a.position.x, b.position.x), std::min(a.position.y, b.position.y));
+    plug::Vec2d end(std::max(a_end.x, b_end.x), std::max(a_end.y, b_end.y));
+
+    return Rect(start, end - start);
+}
+
+
+Rect alignToPixels(const Rect &rect) {
+    if (rect.isEmpty()) return Rect();
+
+    plug::Vec2d start(floor(rect.position.x), floor(rect.position.y));
+    plug::Vec2d end(ceil(rect.getEnd().x), ceil(rect.getEnd().y));
+
+    return Rect(start, end - start);
+}
+
+
+bool isEqual(const Rect &a, const Rect &b) {
+    return isEqual(a.position, b.position) && isEqual(a.size, b.size);
+}
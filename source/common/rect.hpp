@@ -0,0 +1,71 @@
+/**
+ * \file
+ * \brief Contains axis aligned rectangle and functions for it
+*/
+
+
+#ifndef _RECT_H_
+#define _RECT_H_
+
+
+#include "standart/Math/Vec2d.h"
+
+
+/// Axis aligned rectangle in screen coordinates
+struct Rect {
+    plug::Vec2d position;   ///< Top left corner
+    plug::Vec2d size;       ///< Width and height
+
+    /**
+     * \brief Creates empty rectangle
+    */
+    Rect();
+
+    /**
+     * \brief Creates rectangle with specific position and size
+    */
+    Rect(const plug::Vec2d &position_, const plug::Vec2d &size_);
+
+    /**
+     * \brief Returns true if rectangle has no area
+    */
+    bool isEmpty() const;
+
+    /**
+     * \brief Checks if rectangle completely contains other rectangle
+    */
+    bool contains(const Rect &rect) const;
+
+    /**
+     * \brief Returns right bottom corner
+    */
+    plug::Vec2d getEnd() const;
+};
+
+
+/**
+ * \brief Returns common part of two rectangles
+*/
+Rect intersect(const Rect &a, const Rect &b);
+
+
+/**
+ * \brief Returns smallest rectangle that contains both rectangles
+ * \note Empty rectangles are ignored
+*/
+Rect unite(const Rect &a, const Rect &b);
+
+
+/**
+ * \brief Expands rectangle to integer coordinates
+*/
+Rect alignToPixels(const Rect &rect);
+
+
+/**
+ * \brief Checks if rectangles have the same position and size
+*/
+bool isEqual(const Rect &a, const Rect &b);
+
+
+#endif
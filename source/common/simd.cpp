@@ -0,0 +1,20 @@
+/**
+ * \file
+ * \brief Contains vector kernels helpers implementation
+*/
+
+
+#include "common/simd.hpp"
+
+
+// ============================================================================
+
+
+#ifdef SIMD_KERNELS
+
+bool hasAVX2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * \file
+ * \brief Contains switches for vector kernels
+*/
+
+
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+
+// VECTOR KERNELS ARE BUILT ONLY FOR X86, OTHER TARGETS USE SCALAR LOOPS
+#if defined(__GNUC__) && defined(__SSE2__)
+    #define SIMD_KERNELS
+    #include <immintrin.h>
+
+    /// Compiles function with AVX2 instructions regardless of build flags
+    #define AVX2_KERNEL __attribute__((target("avx2")))
+#endif
+
+
+#ifdef SIMD_KERNELS
+
+/**
+ * \brief Returns true if processor and OS support AVX2
+*/
+bool hasAVX2();
+
+#endif
+
+
+#endif
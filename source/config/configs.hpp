@@ -13,6 +13,7 @@
 
 const int SCREEN_W = 1920;                      ///< Screen width in pixels
 const int SCREEN_H = 1080;                      ///< Screen height in pixels
+const float IDLE_SLEEP_TIME = 1.f / 60;         ///< Longest sleep in seconds between event polls while waiting for tick
 
 // PREDEFINED VALUES FOR WINDOW STYLE
 
@@ -31,6 +32,11 @@ const size_t SCROLLBAR_BACKGROUND_COLOR = 0xffffffff;
 const size_t SCROLLBAR_SCROLLER_COLOR = 0x000000ff;
 const float SCROLLBAR_SCROLLER_FACTOR = 0.1f;
 
+// PREDEFINED VALUES FOR FILTERS
+
+const char FILTER_INTENSITY = 20;                   ///< Channel change of lighten and darken filters
+const size_t HEADLESS_BACKGROUND_COLOR = 0xffffffff; ///< Canvas color under transparent pixels in headless mode
+
 // PREDEFINED VALUES FOR LINE EDIT
 
 const float CURSOR_WIDTH = 2.5;             ///< Cursor width
@@ -53,4 +59,16 @@ const float CURSOR_OFFSET = 2;              ///< Cursor position offset from Lin
 /// Path to log file
 #define LOG_FILE "log/log.txt"
 
+/// Path to screenshot file
+#define SCREENSHOT_FILE "screenshot.png"
+
+/// Command line flag for drawing whole frames directly on window instead of redrawing damaged part of cached scene
+#define DIRECT_FLAG "--direct"
+
+/// Command line flag for replaying and presenting frames on separate thread
+#define RENDER_THREAD_FLAG "--render-thread"
+
+/// Command line flag for applying filter to image file on CPU without window
+#define HEADLESS_FLAG "--headless"
+
 #endif
@@ -1,8 +1,17 @@
+#include <algorithm>
+#include <cstring>
 #include "basic/clock.hpp"
 #include "canvas/canvas_stuff.hpp"
+#include "canvas/filters/filters.hpp"
 #include "canvas/plugin_loader.hpp"
 #include "canvas/palettes/palette_manager.hpp"
+#include "common/pixel_convert.hpp"
 #include "common/utils.hpp"
+#include "widget/damage_tracker.hpp"
+#include "widget/frame_scheduler.hpp"
+#include "widget/overlay.hpp"
+#include "widget/render_thread.hpp"
+#include "widget/texture_cache.hpp"
 
 
 // ============================================================================
@@ -43,18 +52,71 @@ struct StyleManager {
 // ============================================================================
 
 
-/// Handles events from SFML window
-void handleInputEvent(sf::RenderWindow &sf_window, MainWindow &main_window, TransformStack &stack);
+/// Names of filters that are available in headless mode, intensity curve needs dialog so it is not available
+const char *const HEADLESS_FILTERS[] = {"lighten", "darken", "monochrome", "negative"};
+
+
+/// Applies predefined filter to image file using software canvas, returns exit code
+int runHeadless(int argc, char *argv[]);
+
+
+/// Returns how long main loop can wait for input before next tick or negative value to wait forever
+float getIdleTimeout(const sf::Clock &timer);
+
+
+/// Waits for event from SFML window no longer than timeout, returns false if nothing happened
+bool waitInputEvent(sf::RenderWindow &sf_window, sf::Event &event, float timeout);
+
+
+/// Handles awaited event if there is one and then all pending events from SFML window
+void handleInputEvent(
+    sf::RenderWindow &sf_window, MainWindow &main_window, TransformStack &stack,
+    sf::Event &event, bool has_event
+);
 
 
 /// Generates and handles tick event
 void handleTimeEvent(sf::Clock &timer, MainWindow &main_window, TransformStack &stack);
 
 
+/// Returns true if scene or overlay must be redrawn
+bool isFrameDamaged();
+
+
+/// Draws damaged part of the scene into texture then copies texture and overlay to window if something is damaged
+void drawOffscreenFrame(MainWindow &main_window, TransformStack &stack, RenderTexture &texture, WindowTarget &window_target);
+
+
+/// Draws whole scene and overlay directly on window if something is damaged
+/// \note Any damage redraws the whole scene here, so direct mode switches to offscreen frames while overlay is in use
+void drawWindowFrame(MainWindow &main_window, TransformStack &stack, WindowTarget &window_target);
+
+
+/// Records overlay, and scene only if it is damaged, then hands them to render thread if something is damaged
+void drawThreadedFrame(MainWindow &main_window, TransformStack &stack, RenderThread &render_thread);
+
+
+/// Returns true if flag is among command line arguments
+bool hasFlag(int argc, char *argv[], const char *flag);
+
+
+/// Draws whole frame into texture and saves it to file
+void saveScreenshot(MainWindow &main_window, TransformStack &stack, const char *filename);
+
+
+/// Prints texture cache counters
+void printTextureCacheStats();
+
+
 // ============================================================================
 
 
-int main() {
+int main(int argc, char *argv[]) {
+    if (hasFlag(argc, argv, HEADLESS_FLAG)) return runHeadless(argc, argv);
+
+    bool is_direct = hasFlag(argc, argv, DIRECT_FLAG);
+    bool is_threaded = hasFlag(argc, argv, RENDER_THREAD_FLAG);
+
     sf::RenderWindow render_window(sf::VideoMode(SCREEN_W, SCREEN_H), "UI", sf::Style::Fullscreen);
 
     // ENABLED VSYNC TO AVOID VISUAL ARTIFACTS WHEN WINDOWS ARE MOVING
@@ -82,29 +144,86 @@ int main() {
 
     sf::Clock timer;
 
-    RenderTexture render_texture;
-    render_texture.create(SCREEN_W, SCREEN_H);
+    WindowTarget window_target(render_window);
 
-    while (render_window.isOpen()) {
-        if (main_window->getStatus() == Widget::Status::Delete) {
-            render_window.close();
-            break;
-        }
+    RenderTexture *render_texture = nullptr;
+    RenderThread *render_thread = nullptr;
 
-        main_window->checkChildren();
+    // TRUE IF SCENE IN RENDER TEXTURE MATCHES THE LAST FRAME
+    bool is_scene_cached = false;
+
+    // RENDER THREAD KEEPS RECORDED SCENE, SO OFFSCREEN TEXTURE IS NOT USED WITH IT
+    if (is_threaded) {
+        render_thread = new RenderThread(render_window, window_target);
+        ASSERT(render_thread, "Failed to allocate render thread!\n");
+    }
+
+    while (true) {
+        // RENDER THREAD REPLAYS AND PRESENTS PREVIOUS FRAME WHILE INPUT IS AWAITED AND HANDLED
+        sf::Event event;
+        bool has_event = waitInputEvent(render_window, event, getIdleTimeout(timer));
 
-        handleInputEvent(render_window, *main_window, stack);
+        handleInputEvent(render_window, *main_window, stack, event, has_event);
         
         handleTimeEvent(timer, *main_window, stack);
+
+        if (main_window->getStatus() == Widget::Status::Delete) break;
+
+        main_window->checkChildren();
+
+        // EVERY VIEW OF CHANGED DOCUMENT IS REDRAWN NO MATTER WHICH ONE HANDLED THE EVENT
+        CANVAS_GROUP.checkRevisions();
         
-        render_texture.clear(Black);
+        if (render_thread)
+            drawThreadedFrame(*main_window, stack, *render_thread);
+        else if (!is_direct || OVERLAY.hasOwner()) {
+            // CACHED SCENE KEEPS DAMAGE REDRAWS PARTIAL, DIRECT MODE USES IT ONLY WHILE OVERLAY IS IN USE
+            // TEXTURE IS CREATED ON FIRST USE, SO DIRECT SESSIONS WITHOUT OVERLAY NEVER ALLOCATE IT
+            if (!render_texture) {
+                render_texture = new RenderTexture();
+                ASSERT(render_texture, "Failed to allocate render texture!\n");
+
+                render_texture->create(SCREEN_W, SCREEN_H);
+            }
+
+            // TEXTURE WAS NOT UPDATED WHILE FRAMES WERE DRAWN DIRECTLY ON WINDOW
+            if (!is_scene_cached) DAMAGE_TRACKER.addFullDamage();
+            is_scene_cached = true;
+
+            drawOffscreenFrame(*main_window, stack, *render_texture, window_target);
+        }
+        else {
+            is_scene_cached = false;
+            drawWindowFrame(*main_window, stack, window_target);
+        }
 
-        main_window->draw(stack, render_texture);
+#ifdef DEBUG_STATS
+        printTextureCacheStats();
+        TEXTURE_CACHE.resetStats();
 
-        render_window.draw(sf::Sprite(render_texture.getSFMLTexture()));
+        // RENDER THREAD COUNTS ITS DRAW CALLS WITHOUT LOCK
+        if (!render_thread) {
+            printf("Draw calls: %lu\n", window_target.getDrawCalls());
+            window_target.resetDrawCalls();
+        }
 
-        render_window.display();
+        if (render_texture) {
+            printf("Offscreen draw calls: %lu\n", render_texture->getDrawCalls());
+            render_texture->resetDrawCalls();
+        }
+#endif
     }
+
+    // WINDOW CAN BE CLOSED ONLY WHEN NOBODY DRAWS ON IT
+    if (render_thread) delete render_thread;
+
+    render_window.close();
+
+#ifdef DEBUG_STATS
+    printTextureCacheStats();
+#endif
+
+    if (render_texture) delete render_texture;
     
     delete main_window;
     main_window = nullptr;
@@ -147,6 +266,7 @@ Widget *StyleManager::createToolPaletteView() {
         true,
         false
     );
+    subwindow->setLayered(true);
 
     subwindow->addChild(new ToolPaletteView(
         Widget::AUTO_ID,
@@ -171,6 +291,7 @@ Widget *StyleManager::createColorPaletteView() {
         true,
         false
     );
+    subwindow->setLayered(true);
 
     subwindow->addChild(new ColorPaletteView(
         Widget::AUTO_ID,
@@ -204,6 +325,7 @@ Menu *StyleManager::createMainMenu(Window &dialog_parent) {
     main_menu->addButton(0, "Open", new CreateOpenFileDialog(dialog_parent, dialog_style, scrollbar_style));
     main_menu->addButton(0, "Save", new SaveFileAction());
     main_menu->addButton(0, "Save As", new CreateSaveAsFileDialog(dialog_parent, dialog_style));
+    main_menu->addButton(0, "New View", new NewViewAction(dialog_parent, window_style, scrollbar_style));
     
     main_menu->addMenuButton("Filter");
     main_menu->addButton(1, "Lighten", new FilterAction(dialog_parent, FilterPalette::LIGHTEN_FILTER));
@@ -230,14 +352,50 @@ void StyleManager::setupMainWindow(MainWindow &window) {
 // ============================================================================
 
 
-void handleInputEvent(sf::RenderWindow &sf_window, MainWindow &main_window, TransformStack &stack) {
-    sf::Event event;
+float getIdleTimeout(const sf::Clock &timer) {
+    if (isFrameDamaged()) return 0;
+
+    float delay = FRAME_SCHEDULER.getWakeUpDelay();
+    if (delay < 0) return FrameScheduler::NO_WAKE_UP;
+
+    // DELAY IS COUNTED FROM THE LAST TICK
+    float timeout = delay - timer.getElapsedTime().asSeconds();
+    return (timeout > 0) ? timeout : 0;
+}
+
+
+bool waitInputEvent(sf::RenderWindow &sf_window, sf::Event &event, float timeout) {
+    if (timeout < 0) return sf_window.waitEvent(event);
+
+    // SFML 2.5 CAN NOT WAIT FOR EVENT WITH TIMEOUT SO WE POLL WITH SHORT SLEEPS
+    sf::Clock wait_timer;
 
-    while (sf_window.pollEvent(event)) {
+    while (!sf_window.pollEvent(event)) {
+        float remaining = timeout - wait_timer.getElapsedTime().asSeconds();
+        if (remaining <= 0) return false;
+
+        sf::sleep(sf::seconds(std::min(remaining, IDLE_SLEEP_TIME)));
+    }
+
+    return true;
+}
+
+
+void handleInputEvent(
+    sf::RenderWindow &sf_window, MainWindow &main_window, TransformStack &stack,
+    sf::Event &event, bool has_event
+) {
+    for (; has_event; has_event = sf_window.pollEvent(event)) {
+        // WINDOW IS CLOSED BY MAIN LOOP AFTER RENDER THREAD IS STOPPED
         if (event.type == sf::Event::Closed) {
-            sf_window.close();
+            main_window.setStatus(Widget::Status::Delete);
             break;
         }
+
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F12) {
+            saveScreenshot(main_window, stack, SCREENSHOT_FILE);
+            continue;
+        }
         
         main_window.parseEvent(event, stack);
     }
@@ -247,7 +405,172 @@ void handleInputEvent(sf::RenderWindow &sf_window, MainWindow &main_window, Tran
 void handleTimeEvent(sf::Clock &timer, MainWindow &main_window, TransformStack &stack) {
     plug::EHC ehc = {stack, false, false};
 
+    FRAME_SCHEDULER.reset();
+
     main_window.onEvent(plug::TickEvent(timer.getElapsedTime().asSeconds()), ehc);
 
     timer.restart();
 }
+
+
+bool isFrameDamaged() {
+    return DAMAGE_TRACKER.isDamaged() || OVERLAY.isDamaged();
+}
+
+
+void drawOffscreenFrame(MainWindow &main_window, TransformStack &stack, RenderTexture &texture, WindowTarget &window_target) {
+    // PREVIOUS FRAME STAYS ON THE SCREEN UNTIL NEXT DISPLAY
+    if (!isFrameDamaged()) return;
+
+    // SCENE IN TEXTURE IS REUSED IF ONLY OVERLAY HAS CHANGED
+    if (DAMAGE_TRACKER.isDamaged()) {
+        // WIDGETS CAN DAMAGE NEXT FRAME WHILE DRAWING SO DAMAGE IS TAKEN BEFORE DRAW
+        texture.pushClip(DAMAGE_TRACKER.getDamage());
+        DAMAGE_TRACKER.reset();
+
+        texture.clear(Black);
+
+        main_window.draw(stack, texture);
+
+        texture.popClip();
+        texture.flush();
+    }
+
+    OVERLAY.reset();
+
+    drawRenderTexture(window_target, texture, plug::Vec2d(), texture.getSize());
+    OVERLAY.draw(window_target);
+
+    window_target.display();
+}
+
+
+void drawWindowFrame(MainWindow &main_window, TransformStack &stack, WindowTarget &window_target) {
+    // PREVIOUS FRAME STAYS ON THE SCREEN UNTIL NEXT DISPLAY
+    if (!isFrameDamaged()) return;
+
+    // WINDOW BACK BUFFER IS UNDEFINED AFTER DISPLAY SO WHOLE FRAME IS REDRAWN
+    DAMAGE_TRACKER.reset();
+    OVERLAY.reset();
+
+    window_target.clear(Black);
+
+    main_window.draw(stack, window_target);
+    OVERLAY.draw(window_target);
+
+    window_target.display();
+}
+
+
+void drawThreadedFrame(MainWindow &main_window, TransformStack &stack, RenderThread &render_thread) {
+    if (!isFrameDamaged()) return;
+
+    // RENDER THREAD REPLAYS THE LAST RECORDED SCENE, SO IT IS RECORDED AGAIN ONLY IF IT IS DAMAGED
+    if (DAMAGE_TRACKER.isDamaged()) {
+        // WIDGETS CAN DAMAGE NEXT FRAME WHILE DRAWING SO DAMAGE IS TAKEN BEFORE DRAW
+        DAMAGE_TRACKER.reset();
+
+        main_window.draw(stack, render_thread.getSceneList());
+    }
+
+    OVERLAY.reset();
+    OVERLAY.draw(render_thread.getOverlayList());
+
+    render_thread.submit();
+}
+
+
+void saveScreenshot(MainWindow &main_window, TransformStack &stack, const char *filename) {
+    RenderTexture texture;
+    texture.create(SCREEN_W, SCREEN_H);
+
+    texture.clear(Black);
+
+    main_window.draw(stack, texture);
+    OVERLAY.draw(texture);
+
+    const plug::Texture &result = texture.getTexture();
+
+    sf::Image image;
+    image.create(result.width, result.height, reinterpret_cast<const uint8_t*>(result.data));
+
+    if (!image.saveToFile(filename))
+        printf("Failed to save screenshot to %s!\n", filename);
+}
+
+
+int runHeadless(int argc, char *argv[]) {
+    int flag = 1;
+    while (strcmp(argv[flag], HEADLESS_FLAG) != 0) flag++;
+
+    if (argc - flag != 4) {
+        printf("Usage: %s " HEADLESS_FLAG " <filter> <input> <output>\n", argv[0]);
+        return 1;
+    }
+
+    const char *filter_name = argv[flag + 1];
+    const char *input = argv[flag + 2];
+    const char *output = argv[flag + 3];
+
+    size_t filter_count = sizeof(HEADLESS_FILTERS) / sizeof(HEADLESS_FILTERS[0]);
+
+    size_t filter_id = 0;
+    while (filter_id < filter_count && strcmp(HEADLESS_FILTERS[filter_id], filter_name) != 0) filter_id++;
+
+    if (filter_id == filter_count) {
+        printf("Unknown filter %s!\n", filter_name);
+        return 1;
+    }
+
+    sf::Image image;
+    if (!image.loadFromFile(input)) {
+        printf("Failed to open %s!\n", input);
+        return 1;
+    }
+
+    // FILTERS ARE CREATED DIRECTLY, STYLES AND PALETTES WOULD LOAD FONTS AND CREATE GPU TEXTURES
+    IntensityFilter lighten(FILTER_INTENSITY), darken(-FILTER_INTENSITY);
+    MonochromeFilter monochrome;
+    NegativeFilter negative;
+
+    const plug::Filter *const filters[] = {&lighten, &darken, &monochrome, &negative};
+    static_assert(
+        sizeof(filters) / sizeof(filters[0]) == sizeof(HEADLESS_FILTERS) / sizeof(HEADLESS_FILTERS[0]),
+        "Every headless filter must have a name!\n"
+    );
+
+    SoftwareCanvas canvas;
+    canvas.setSize(getPlugVector(image.getSize()), hex2Color(HEADLESS_BACKGROUND_COLOR));
+
+    plug::Texture texture(image.getSize().x, image.getSize().y);
+    convertRGBAToColors(texture.data, image.getPixelsPtr(), texture.width * texture.height);
+
+    TextureShape(texture).draw(canvas, plug::Vec2d(), canvas.getSize());
+
+    filters[filter_id]->applyFilter(canvas);
+
+    if (!canvas.saveToFile(output)) {
+        printf("Failed to save image to %s!\n", output);
+        return 1;
+    }
+
+    return 0;
+}
+
+
+bool hasFlag(int argc, char *argv[], const char *flag) {
+    for (int i = 1; i < argc; i++)
+        if (strcmp(argv[i], flag) == 0) return true;
+
+    return false;
+}
+
+
+void printTextureCacheStats() {
+    const TextureCacheStats &stats = TEXTURE_CACHE.getStats();
+
+    printf(
+        "Texture cache: %lu hits, %lu misses, %lu bytes uploaded\n",
+        stats.hits, stats.misses, stats.uploaded_bytes
+    );
+}
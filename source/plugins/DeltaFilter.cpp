@@ -35,22 +35,11 @@ DeltaFilter::DeltaFilter(char intensity_) :
 
 
 void DeltaFilter::applyFilter(plug::Canvas &canvas) const {
-    plug::SelectionMask &mask = canvas.getSelectionMask();
-    plug::Texture texture(canvas.getTexture());
-
-    for (size_t y = 0; y < mask.getHeight(); y++) {
-        for (size_t x = 0; x < mask.getWidth(); x++) {
-            if (mask.getPixel(x, y)) {
-                plug::Color origin(texture.getPixel(x, y));
-                
-                texture.setPixel(x, y, plug::Color(
-                    clip(origin.r),
-                    clip(origin.g),
-                    clip(origin.b)
-                ));
-            }
-        }
-    }
-
-    TextureShape(texture).draw(canvas, plug::Vec2d(), canvas.getSize());
+    transformSelection(canvas, [this](const plug::Color &origin) {
+        return plug::Color(
+            clip(origin.r),
+            clip(origin.g),
+            clip(origin.b)
+        );
+    });
 }
@@ -53,6 +53,67 @@ public:
    * \brief Get texture of canvas
    */
   virtual const Texture &getTexture(void) const = 0;
+
+  /**
+   * \brief Copy colors of pixels in rectangle to buffer with width colors in
+   * each row
+   *
+   * \note Default implementation calls getPixel for every pixel
+   */
+  virtual void copyPixels(size_t x, size_t y, size_t width, size_t height,
+                          Color *pixels) const {
+    for (size_t j = 0; j < height; ++j) {
+      for (size_t i = 0; i < width; ++i) {
+        pixels[j * width + i] = getPixel(x + i, y + j);
+      }
+    }
+  }
+
+  /**
+   * \brief Set colors of pixels in rectangle from buffer with width colors in
+   * each row
+   *
+   * \note Default implementation calls setPixel for every pixel
+   */
+  virtual void setPixels(size_t x, size_t y, size_t width, size_t height,
+                         const Color *pixels) {
+    for (size_t j = 0; j < height; ++j) {
+      for (size_t i = 0; i < width; ++i) {
+        setPixel(x + i, y + j, pixels[j * width + i]);
+      }
+    }
+  }
+
+  /**
+   * \brief Set color of length pixels in row starting from coordinates
+   *
+   * \note Default implementation calls setPixel for every pixel
+   */
+  virtual void fillSpan(size_t x, size_t y, size_t length,
+                        const Color &color) {
+    for (size_t i = 0; i < length; ++i) {
+      setPixel(x + i, y, color);
+    }
+  }
+
+  /**
+   * \brief Set colors of pixels in rectangle from buffer with width colors in
+   * each row, only pixels selected by mask are changed
+   *
+   * \note Mask is indexed by canvas coordinates
+   * \note Default implementation calls setPixel for every selected pixel
+   */
+  virtual void setPixelsMasked(size_t x, size_t y, size_t width,
+                               size_t height, const Color *pixels,
+                               const SelectionMask &mask) {
+    for (size_t j = 0; j < height; ++j) {
+      for (size_t i = 0; i < width; ++i) {
+        if (mask.getPixel(x + i, y + j)) {
+          setPixel(x + i, y + j, pixels[j * width + i]);
+        }
+      }
+    }
+  }
 };
 
 } // namespace plug
@@ -37,6 +37,33 @@ public:
    * \brief Invert every boolean flag of mask's cells
    */
   virtual void invert(void) = 0;
+
+  /**
+   * \brief Find first run of set cells in row y that ends after x
+   *
+   * \return false if there are no set cells in [x, width), otherwise run is
+   * [begin, end) and begin is not less than x
+   * \note Default implementation calls getPixel for every cell
+   */
+  virtual bool findRun(size_t x, size_t y, size_t &begin, size_t &end) const {
+    size_t width = getWidth();
+
+    while (x < width && !getPixel(x, y)) {
+      ++x;
+    }
+
+    if (x >= width) {
+      return false;
+    }
+
+    begin = x;
+    while (x < width && getPixel(x, y)) {
+      ++x;
+    }
+
+    end = x;
+    return true;
+  }
 };
 
 } // namespace plug
@@ -0,0 +1,39 @@
+/**
+ * \file
+ * \brief Contains damage tracker implementation
+*/
+
+
+#include "config/configs.hpp"
+#include "widget/damage_tracker.hpp"
+
+
+// ============================================================================
+
+
+DamageTracker::DamageTracker() :
+    screen(plug::Vec2d(), plug::Vec2d(SCREEN_W, SCREEN_H)), damage(screen)
+{}
+
+
+void DamageTracker::addDamage(const Rect &rect) {
+    damage = unite(damage, intersect(rect, screen));
+}
+
+
+void DamageTracker::addFullDamage() { damage = screen; }
+
+
+bool DamageTracker::isDamaged() const { return !damage.isEmpty(); }
+
+
+Rect DamageTracker::getDamage() const { return alignToPixels(damage); }
+
+
+void DamageTracker::reset() { damage = Rect(); }
+
+
+DamageTracker &DamageTracker::getInstance() {
+    static DamageTracker damage_tracker;
+    return damage_tracker;
+}
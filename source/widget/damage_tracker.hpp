@@ -0,0 +1,67 @@
+/**
+ * \file
+ * \brief Contains damage tracker interface
+*/
+
+
+#ifndef _DAMAGE_TRACKER_H_
+#define _DAMAGE_TRACKER_H_
+
+
+#include "common/rect.hpp"
+
+
+/**
+ * \brief Collects screen regions that must be redrawn on the next frame
+ * \note This class is a singleton (you must use getInstance to get it)
+*/
+class DamageTracker {
+public:
+    /**
+     * \brief Marks region as damaged
+    */
+    void addDamage(const Rect &rect);
+
+    /**
+     * \brief Marks whole screen as damaged
+    */
+    void addFullDamage();
+
+    /**
+     * \brief Returns true if some region must be redrawn
+    */
+    bool isDamaged() const;
+
+    /**
+     * \brief Returns union of all damaged regions clipped by screen
+    */
+    Rect getDamage() const;
+
+    /**
+     * \brief Forgets all damaged regions
+     * \note Call this method before drawing frame so widgets can damage next frame while drawing
+    */
+    void reset();
+
+    /**
+     * \brief Returns single instance of DamageTracker
+    */
+    static DamageTracker &getInstance();
+
+private:
+    DamageTracker();
+
+    DamageTracker(const DamageTracker&) = delete;
+
+    DamageTracker &operator = (const DamageTracker&) = delete;
+
+    Rect screen;        ///< Whole screen region
+    Rect damage;        ///< Union of damaged regions
+};
+
+
+/// Shortcut for getting DamageTracker instance
+#define DAMAGE_TRACKER DamageTracker::getInstance()
+
+
+#endif
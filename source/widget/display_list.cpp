@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \brief Contains display list implementation
+*/
+
+
+#include "common/assert.hpp"
+#include "widget/display_list.hpp"
+#include "widget/texture_cache.hpp"
+#include "widget/transform.hpp"
+
+
+// ============================================================================
+
+
+DisplayList::DisplayList() :
+    vertices(plug::Points, 0), commands(), array(plug::Points, 0), clip_depth(0), uploads() {}
+
+
+void DisplayList::draw(const plug::VertexArray& array_) {
+    record(array_, nullptr, nullptr);
+}
+
+
+void DisplayList::draw(const plug::VertexArray& array_, const plug::Texture& texture) {
+    record(array_, &texture, nullptr);
+}
+
+
+void DisplayList::draw(const plug::VertexArray& array_, const sf::Texture &texture) {
+    record(array_, nullptr, &texture);
+}
+
+
+void DisplayList::clear(plug::Color color) {
+    ASSERT(0, "Display list can not be cleared!\n");
+}
+
+
+void DisplayList::pushClip(const Rect &rect) {
+    commands.push_back({Type::PushClip, plug::Points, 0, 0, nullptr, nullptr, rect});
+    clip_depth++;
+}
+
+
+void DisplayList::popClip() {
+    ASSERT(clip_depth, "Clip stack is empty!\n");
+
+    commands.push_back({Type::PopClip, plug::Points, 0, 0, nullptr, nullptr, Rect()});
+    clip_depth--;
+}
+
+
+void DisplayList::record(const plug::VertexArray &array_, const plug::Texture *texture, const sf::Texture *sfml_texture) {
+    if (array_.getSize() == 0) return;
+
+    commands.push_back({
+        Type::Draw, array_.getPrimitive(), vertices.getSize(), array_.getSize(),
+        texture, sfml_texture, Rect()
+    });
+
+    for (size_t i = 0; i < array_.getSize(); i++)
+        vertices.appendVertex(array_[i]);
+}
+
+
+void DisplayList::replay(const plug::TransformStack &stack, plug::RenderTarget &target) const {
+    SFMLTextureTarget *sfml_target = dynamic_cast<SFMLTextureTarget*>(&target);
+    ClipTarget *clip_target = dynamic_cast<ClipTarget*>(&target);
+
+    for (size_t i = 0; i < commands.size(); i++) {
+        const Command &command = commands[i];
+
+        if (command.type == Type::PushClip) {
+            if (clip_target) clip_target->pushClip(Rect(
+                stack.apply(command.clip.position), applySize(stack, command.clip.size)
+            ));
+            continue;
+        }
+
+        if (command.type == Type::PopClip) {
+            if (clip_target) clip_target->popClip();
+            continue;
+        }
+
+        array.setPrimitive(command.primitive);
+        array.resize(command.count);
+
+        for (size_t j = 0; j < command.count; j++) {
+            array[j] = vertices[command.first + j];
+            array[j].position = stack.apply(array[j].position);
+        }
+
+        if (command.texture)
+            target.draw(array, *command.texture);
+        else if (command.sfml_texture) {
+            // LIST IS RECORDED ONLY FOR TARGETS THAT ACCEPT SFML TEXTURES
+            ASSERT(sfml_target, "Target does not accept SFML textures!\n");
+            sfml_target->draw(array, *command.sfml_texture);
+        }
+        else
+            target.draw(array);
+    }
+}
+
+
+void DisplayList::uploadTextures() {
+    size_t used = 0;
+
+    for (size_t i = 0; i < commands.size(); i++) {
+        Command &command = commands[i];
+        if (!command.texture) continue;
+
+        // EVERY NOT RETAINED TEXTURE GETS ITS OWN GPU COPY, SO THEY DO NOT OVERWRITE EACH OTHER
+        if (used == uploads.size()) {
+            sf::Texture *upload = new sf::Texture();
+            ASSERT(upload, "Failed to allocate texture!\n");
+
+            uploads.push_back(upload);
+        }
+
+        bool is_retained = TEXTURE_CACHE.isRetained(*command.texture);
+
+        // RETAINED GPU COPY IS SHARED, SO OTHER TARGETS MUST SUBMIT DRAWS WITH ITS OLD CONTENT FIRST
+        if (is_retained && !TEXTURE_CACHE.isResident(*command.texture)) ::RenderTarget::flushAll();
+
+        command.sfml_texture = &TEXTURE_CACHE.getTexture(*command.texture, *uploads[used]);
+        command.texture = nullptr;
+
+        if (!is_retained) used++;
+    }
+}
+
+
+void DisplayList::reset() {
+    ASSERT(!clip_depth, "Recorded clips are not popped!\n");
+
+    vertices.resize(0);
+    commands.resize(0, Command{});
+}
+
+
+DisplayList::~DisplayList() {
+    for (size_t i = 0; i < uploads.size(); i++)
+        delete uploads[i];
+}
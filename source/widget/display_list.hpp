@@ -0,0 +1,118 @@
+/**
+ * \file
+ * \brief Contains display list interface
+*/
+
+
+#ifndef _DISPLAY_LIST_H_
+#define _DISPLAY_LIST_H_
+
+
+#include "common/list.hpp"
+#include "widget/render_target.hpp"
+
+
+/**
+ * \brief Target that records draws so they can be replayed later under another transform
+ * \note Textures are stored by pointer and must outlive the list
+*/
+class DisplayList : public plug::RenderTarget, public SFMLTextureTarget, public ClipTarget {
+public:
+    DisplayList();
+
+    DisplayList(const DisplayList&) = delete;
+
+    DisplayList &operator = (const DisplayList&) = delete;
+
+    /**
+     * \brief Records vertex array
+    */
+    virtual void draw(const plug::VertexArray& array) override;
+
+    /**
+     * \brief Records vertex array with texture
+    */
+    virtual void draw(const plug::VertexArray& array, const plug::Texture& texture) override;
+
+    /**
+     * \brief Records vertex array with SFML texture
+    */
+    virtual void draw(const plug::VertexArray& array, const sf::Texture &texture) override;
+
+    /**
+     * \brief Clears can not be recorded
+     * \warning Aborts program
+    */
+    virtual void clear(plug::Color color) override;
+
+    /**
+     * \brief Deprecated method
+    */
+    virtual void setActive(bool active) override {}
+
+    /**
+     * \brief Records clip rectangle
+    */
+    virtual void pushClip(const Rect &rect) override;
+
+    /**
+     * \brief Records clip restoring
+    */
+    virtual void popClip() override;
+
+    /**
+     * \brief Draws all recorded arrays on target applying stack transform to vertex positions
+     * \note Clips are transformed the same way and skipped if target can not clip
+    */
+    void replay(const plug::TransformStack &stack, plug::RenderTarget &target) const;
+
+    /**
+     * \brief Replaces plug textures of recorded draws with their GPU copies
+     * \note After this call list can be replayed without TextureCache, so another thread can replay it
+     * \note Textures that are not retained are uploaded to GPU textures owned by the list
+    */
+    void uploadTextures();
+
+    /**
+     * \brief Forgets all recorded draws
+    */
+    void reset();
+
+    /**
+     * \brief Deletes GPU copies of not retained textures
+    */
+    virtual ~DisplayList() override;
+
+private:
+    /// Kind of recorded command
+    enum class Type {
+        Draw,                               ///< Vertex array draw
+        PushClip,                           ///< pushClip() call
+        PopClip,                            ///< popClip() call
+    };
+
+    /// Recorded command
+    struct Command {
+        Type type;                          ///< Kind of command
+        plug::PrimitiveType primitive;      ///< Primitive of recorded array
+        size_t first;                       ///< Index of the first vertex in vertices
+        size_t count;                       ///< Amount of vertices
+        const plug::Texture *texture;       ///< Texture or nullptr
+        const sf::Texture *sfml_texture;    ///< SFML texture or nullptr
+        Rect clip;                          ///< Clip rectangle of PushClip command
+    };
+
+    /**
+     * \brief Copies array vertices and adds command for them
+    */
+    void record(const plug::VertexArray &array, const plug::Texture *texture, const sf::Texture *sfml_texture);
+
+    plug::VertexArray vertices;             ///< Vertices of all recorded arrays
+    List<Command> commands;                 ///< Recorded draws in order
+    mutable plug::VertexArray array;        ///< Tool array for replay
+    size_t clip_depth;                      ///< Amount of recorded clips that are not popped
+    List<sf::Texture*> uploads;             ///< GPU copies of not retained textures, reused between frames
+};
+
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * \file
+ * \brief Contains frame scheduler implementation
+*/
+
+
+#include "widget/frame_scheduler.hpp"
+
+
+// ============================================================================
+
+
+FrameScheduler::FrameScheduler() : wake_up_delay(NO_WAKE_UP) {}
+
+
+void FrameScheduler::requestWakeUp(float delay) {
+    if (delay < 0) delay = 0;
+
+    if (wake_up_delay < 0 || delay < wake_up_delay)
+        wake_up_delay = delay;
+}
+
+
+void FrameScheduler::requestAnimation() { wake_up_delay = 0; }
+
+
+float FrameScheduler::getWakeUpDelay() const { return wake_up_delay; }
+
+
+void FrameScheduler::reset() { wake_up_delay = NO_WAKE_UP; }
+
+
+FrameScheduler &FrameScheduler::getInstance() {
+    static FrameScheduler frame_scheduler;
+    return frame_scheduler;
+}
@@ -0,0 +1,63 @@
+/**
+ * \file
+ * \brief Contains frame scheduler interface
+*/
+
+
+#ifndef _FRAME_SCHEDULER_H_
+#define _FRAME_SCHEDULER_H_
+
+
+/**
+ * \brief Collects wake-up requests from widgets so main loop can sleep until something must change
+ * \note Requests are collected during tick and forgotten on the next one
+ * \note This class is a singleton (you must use getInstance to get it)
+*/
+class FrameScheduler {
+public:
+    /// Delay returned when nobody asked to wake up
+    static constexpr float NO_WAKE_UP = -1;
+
+    /**
+     * \brief Asks main loop to send tick no later than delay seconds after the current one
+    */
+    void requestWakeUp(float delay);
+
+    /**
+     * \brief Asks main loop to send tick on the next frame
+    */
+    void requestAnimation();
+
+    /**
+     * \brief Returns time in seconds between the last tick and the earliest requested one
+     * \note Returns NO_WAKE_UP if main loop can wait for input forever
+    */
+    float getWakeUpDelay() const;
+
+    /**
+     * \brief Forgets all requests
+     * \note Call this method before sending tick so widgets can request the next one
+    */
+    void reset();
+
+    /**
+     * \brief Returns single instance of FrameScheduler
+    */
+    static FrameScheduler &getInstance();
+
+private:
+    FrameScheduler();
+
+    FrameScheduler(const FrameScheduler&) = delete;
+
+    FrameScheduler &operator = (const FrameScheduler&) = delete;
+
+    float wake_up_delay;        ///< The earliest requested delay or NO_WAKE_UP
+};
+
+
+/// Shortcut for getting FrameScheduler instance
+#define FRAME_SCHEDULER FrameScheduler::getInstance()
+
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * \file
+ * \brief Contains glyph atlas and glyph cache implementation
+*/
+
+
+#include "common/assert.hpp"
+#include "common/pixel_convert.hpp"
+#include "widget/glyph_atlas.hpp"
+#include "widget/render_fence.hpp"
+#include "widget/texture_cache.hpp"
+
+
+const size_t TAB_WIDTH = 4;     ///< Tab width in spaces
+
+
+// ============================================================================
+
+
+GlyphAtlas::GlyphAtlas(const sf::Font &font_, unsigned character_size_) :
+    font(font_), character_size(character_size_),
+    ascii_glyphs(), glyphs(), texture(nullptr), is_texture_valid(false)
+{
+    // ALL ASCII GLYPHS ARE LOADED AT ONCE SO USUAL TEXT NEVER CHANGES GLYPH TEXTURE
+    for (size_t i = 0; i < ASCII_GLYPHS; i++)
+        ascii_glyphs[i] = font.getGlyph(i, character_size, false);
+}
+
+
+const sf::Glyph &GlyphAtlas::getGlyph(sf::Uint32 code) {
+    if (code < ASCII_GLYPHS) return ascii_glyphs[code];
+
+    for (size_t i = 0; i < glyphs.size(); i++)
+        if (glyphs[i].code == code) return glyphs[i].glyph;
+
+    // SFML DRAWS NEW GLYPH INTO FONT PAGE AND CAN RESIZE IT WHILE RENDER THREAD SAMPLES IT
+    RENDER_FENCE.wait();
+
+    glyphs.push_back({code, font.getGlyph(code, character_size, false)});
+    is_texture_valid = false;
+
+    return glyphs[glyphs.size() - 1].glyph;
+}
+
+
+void GlyphAtlas::appendText(
+    plug::VertexArray &quads, const sf::String &string,
+    const plug::Vec2d &position, plug::Color color, const Rect &clip
+) {
+    ASSERT(quads.getPrimitive() == plug::Quads, "Quads array expected!\n");
+
+    // BASELINE OF THE FIRST LINE IS ONE CHARACTER SIZE BELOW TOP, AS IN sf::Text
+    plug::Vec2d pen(0, character_size);
+    sf::Uint32 prev_code = 0;
+
+    for (size_t i = 0; i < string.getSize(); i++) {
+        sf::Uint32 code = string[i];
+
+        pen.x += font.getKerning(prev_code, code, character_size);
+        prev_code = code;
+
+        switch (code) {
+            case '\n':
+                pen = plug::Vec2d(0, pen.y + font.getLineSpacing(character_size));
+                break;
+            case '\t':
+                pen.x += getGlyph(' ').advance * TAB_WIDTH;
+                break;
+            default: {
+                const sf::Glyph &glyph = getGlyph(code);
+
+                appendGlyph(quads, glyph, position + pen, color, clip);
+                pen.x += glyph.advance;
+                break;
+            }
+        }
+    }
+}
+
+
+void GlyphAtlas::appendGlyph(
+    plug::VertexArray &quads, const sf::Glyph &glyph,
+    const plug::Vec2d &position, plug::Color color, const Rect &clip
+) const {
+    Rect quad(
+        position + plug::Vec2d(glyph.bounds.left, glyph.bounds.top),
+        plug::Vec2d(glyph.textureRect.width, glyph.textureRect.height)
+    );
+
+    Rect visible = intersect(quad, clip);
+    if (visible.isEmpty()) return;
+
+    // GLYPHS ARE NOT SCALED SO CLIPPING SHIFTS TEXTURE COORDINATES AS MUCH AS POSITION
+    plug::Vec2d tex_start = plug::Vec2d(glyph.textureRect.left, glyph.textureRect.top) + visible.position - quad.position;
+    plug::Vec2d tex_end = tex_start + visible.size;
+
+    plug::Vec2d start = visible.position;
+    plug::Vec2d end = visible.getEnd();
+
+    quads.appendVertex(plug::Vertex(start, color, tex_start));
+    quads.appendVertex(plug::Vertex(plug::Vec2d(start.x, end.y), color, plug::Vec2d(tex_start.x, tex_end.y)));
+    quads.appendVertex(plug::Vertex(end, color, tex_end));
+    quads.appendVertex(plug::Vertex(plug::Vec2d(end.x, start.y), color, plug::Vec2d(tex_end.x, tex_start.y)));
+}
+
+
+const sf::Font &GlyphAtlas::getFont() const { return font; }
+
+
+unsigned GlyphAtlas::getCharacterSize() const { return character_size; }
+
+
+const sf::Texture &GlyphAtlas::getSFMLTexture() const {
+    return font.getTexture(character_size);
+}
+
+
+const plug::Texture &GlyphAtlas::getTexture() {
+    if (!is_texture_valid) updateTexture();
+
+    return *texture;
+}
+
+
+void GlyphAtlas::updateTexture() {
+    // SFML RASTERIZES GLYPHS DIRECTLY INTO GPU TEXTURE, SO CPU COPY CAN ONLY BE READ BACK
+    sf::Image image = getSFMLTexture().copyToImage();
+    sf::Vector2u size = image.getSize();
+
+    if (!texture || texture->width != size.x || texture->height != size.y) {
+        if (texture) {
+            TEXTURE_CACHE.release(*texture);
+            delete texture;
+        }
+
+        texture = new plug::Texture(size.x, size.y);
+        ASSERT(texture, "Failed to allocate texture!\n");
+
+        TEXTURE_CACHE.retain(*texture);
+    }
+
+    convertRGBAToColors(texture->data, image.getPixelsPtr(), size.x * size.y);
+
+    TEXTURE_CACHE.markChanged(*texture);
+    is_texture_valid = true;
+}
+
+
+GlyphAtlas::~GlyphAtlas() {
+    if (texture) {
+        TEXTURE_CACHE.release(*texture);
+        delete texture;
+    }
+}
+
+
+// ============================================================================
+
+
+GlyphCache::GlyphCache() : entries() {
+    // TEXTURE CACHE MUST BE DESTROYED AFTER ATLASES THAT RELEASE TEXTURES IN IT
+    TextureCache::getInstance();
+}
+
+
+GlyphAtlas &GlyphCache::retain(const sf::Font &font, unsigned character_size) {
+    for (size_t i = 0; i < entries.size(); i++) {
+        GlyphAtlas &atlas = *entries[i].atlas;
+
+        if (&atlas.getFont() == &font && atlas.getCharacterSize() == character_size) {
+            entries[i].references++;
+            return atlas;
+        }
+    }
+
+    GlyphAtlas *atlas = new GlyphAtlas(font, character_size);
+    ASSERT(atlas, "Failed to allocate glyph atlas!\n");
+
+    entries.push_back({atlas, 1});
+
+    return *atlas;
+}
+
+
+void GlyphCache::release(const GlyphAtlas &atlas) {
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].atlas != &atlas) continue;
+
+        // ATLAS IS DELETED WITH THE LAST USER, SO IT NEVER OUTLIVES TEMPORARY FONTS
+        if (--entries[i].references == 0) {
+            delete entries[i].atlas;
+            entries.remove(i);
+        }
+
+        return;
+    }
+
+    ASSERT(0, "Glyph atlas is not retained!\n");
+}
+
+
+GlyphCache &GlyphCache::getInstance() {
+    static GlyphCache glyph_cache;
+    return glyph_cache;
+}
+
+
+GlyphCache::~GlyphCache() {
+    for (size_t i = 0; i < entries.size(); i++)
+        delete entries[i].atlas;
+}
@@ -0,0 +1,155 @@
+/**
+ * \file
+ * \brief Contains glyph atlas and glyph cache interface
+*/
+
+
+#ifndef _GLYPH_ATLAS_H_
+#define _GLYPH_ATLAS_H_
+
+
+#include "SFML/Graphics.hpp"
+#include "common/list.hpp"
+#include "common/rect.hpp"
+#include "standart/Graphics.h"
+
+
+/**
+ * \brief Glyphs of one font with one character size packed into one texture
+ * \note Glyphs are rasterized by SFML into font page texture, atlas only builds quads for them
+ * \note Only regular text style is supported
+*/
+class GlyphAtlas {
+public:
+    /**
+     * \brief Creates atlas and loads ASCII glyphs into it
+    */
+    GlyphAtlas(const sf::Font &font_, unsigned character_size_);
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+
+    GlyphAtlas &operator = (const GlyphAtlas&) = delete;
+
+    /**
+     * \brief Returns glyph loading it into atlas if needed
+    */
+    const sf::Glyph &getGlyph(sf::Uint32 code);
+
+    /**
+     * \brief Appends quads of the string to array, quads are clipped by clip rectangle
+     * \note Position is top left corner of the first line
+     * \note Array primitive must be plug::Quads
+    */
+    void appendText(
+        plug::VertexArray &quads, const sf::String &string,
+        const plug::Vec2d &position, plug::Color color, const Rect &clip
+    );
+
+    /**
+     * \brief Returns font
+    */
+    const sf::Font &getFont() const;
+
+    /**
+     * \brief Returns character size
+    */
+    unsigned getCharacterSize() const;
+
+    /**
+     * \brief Returns GPU texture with all glyphs
+    */
+    const sf::Texture &getSFMLTexture() const;
+
+    /**
+     * \brief Returns CPU copy of the texture with all glyphs
+     * \warning Copy is read back from GPU if glyphs were added since the last call
+    */
+    const plug::Texture &getTexture();
+
+    /**
+     * \brief Frees CPU copy of glyph texture
+    */
+    ~GlyphAtlas();
+
+private:
+    /// Glyph that is not in ASCII table
+    struct GlyphEntry {
+        sf::Uint32 code;            ///< Character code
+        sf::Glyph glyph;            ///< Glyph itself
+    };
+
+    /// Amount of glyphs stored in fast lookup table
+    static const size_t ASCII_GLYPHS = 128;
+
+    /**
+     * \brief Appends quad of the glyph clipped by clip rectangle
+    */
+    void appendGlyph(
+        plug::VertexArray &quads, const sf::Glyph &glyph,
+        const plug::Vec2d &position, plug::Color color, const Rect &clip
+    ) const;
+
+    /**
+     * \brief Copies glyph texture from GPU to CPU
+    */
+    void updateTexture();
+
+    const sf::Font &font;                       ///< Glyph font
+    unsigned character_size;                    ///< Glyph character size
+    sf::Glyph ascii_glyphs[ASCII_GLYPHS];       ///< Glyphs of ASCII characters
+    List<GlyphEntry> glyphs;                    ///< Glyphs of other characters
+    plug::Texture *texture;                     ///< CPU copy of glyph texture
+    bool is_texture_valid;                      ///< False if CPU copy is outdated
+};
+
+
+/**
+ * \brief Shares glyph atlases between all text with the same font and character size
+ * \note This class is a singleton (you must use getInstance to get it)
+*/
+class GlyphCache {
+public:
+    /**
+     * \brief Returns atlas for font and character size creating it if needed
+     * \note Every retain() call must be paired with release()
+    */
+    GlyphAtlas &retain(const sf::Font &font, unsigned character_size);
+
+    /**
+     * \brief Deletes atlas when it is no longer used
+     * \warning Call this method before deleting atlas font
+    */
+    void release(const GlyphAtlas &atlas);
+
+    /**
+     * \brief Returns single instance of GlyphCache
+    */
+    static GlyphCache &getInstance();
+
+    /**
+     * \brief Deletes all atlases
+    */
+    ~GlyphCache();
+
+private:
+    /// Shared atlas
+    struct Entry {
+        GlyphAtlas *atlas;          ///< Atlas itself
+        size_t references;          ///< Amount of retain() calls without release()
+    };
+
+    GlyphCache();
+
+    GlyphCache(const GlyphCache&) = delete;
+
+    GlyphCache &operator = (const GlyphCache&) = delete;
+
+    List<Entry> entries;            ///< Shared atlases
+};
+
+
+/// Shortcut for getting GlyphCache instance
+#define GLYPH_CACHE GlyphCache::getInstance()
+
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * \file
+ * \brief Contains overlay implementation
+*/
+
+
+#include "widget/overlay.hpp"
+#include "widget/widget.hpp"
+
+
+// ============================================================================
+
+
+Overlay::Overlay() : owner(nullptr), is_damaged(false) {}
+
+
+void Overlay::setOwner(Widget &widget) {
+    if (owner != &widget) damage();
+
+    owner = &widget;
+}
+
+
+void Overlay::release(Widget &widget) {
+    if (owner != &widget) return;
+
+    owner = nullptr;
+    damage();
+}
+
+
+bool Overlay::isOwner(const Widget &widget) const { return owner == &widget; }
+
+
+bool Overlay::hasOwner() const { return owner; }
+
+
+void Overlay::damage() { is_damaged = true; }
+
+
+bool Overlay::isDamaged() const { return is_damaged; }
+
+
+void Overlay::reset() { is_damaged = false; }
+
+
+void Overlay::draw(plug::RenderTarget &target) {
+    if (!owner) return;
+
+    Rect rect = owner->getGlobalRect();
+
+    // OVERLAY IS ABOVE EVERYTHING, SO IT MUST NOT COVER WIDGETS PLACED OVER THE OWNER
+    if (owner->isOccluded(rect)) {
+        Widget *occluded = owner;
+        owner = nullptr;
+
+        occluded->invalidate();
+        return;
+    }
+
+    ClipApplier clip(target, rect);
+
+    // OWNER GETS THE SAME STACK AS ITS DRAW() BUT IN SCREEN COORDINATES
+    TransformStack stack;
+    if (owner->getParent()) stack.enter(owner->getParent()->getGlobalTransform());
+
+    owner->drawOverlay(stack, target);
+}
+
+
+Overlay &Overlay::getInstance() {
+    static Overlay overlay;
+    return overlay;
+}
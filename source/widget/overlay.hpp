@@ -0,0 +1,89 @@
+/**
+ * \file
+ * \brief Contains overlay interface
+*/
+
+
+#ifndef _OVERLAY_H_
+#define _OVERLAY_H_
+
+
+#include "standart/Graphics.h"
+
+
+class Widget;
+
+
+/**
+ * \brief Layer that is drawn over the cached scene, so its changes do not redraw widgets under it
+ * \note Only one widget can own overlay at a time, it draws overlay content using Widget::drawOverlay()
+ * \note This class is a singleton (you must use getInstance to get it)
+*/
+class Overlay {
+public:
+    /**
+     * \brief Makes widget draw its overlay content over the scene
+     * \note Overlay of the previous owner is damaged
+    */
+    void setOwner(Widget &widget);
+
+    /**
+     * \brief Damages overlay and forgets owner if widget owns overlay
+    */
+    void release(Widget &widget);
+
+    /**
+     * \brief Returns true if widget owns overlay
+    */
+    bool isOwner(const Widget &widget) const;
+
+    /**
+     * \brief Returns true if some widget draws its content on overlay
+    */
+    bool hasOwner() const;
+
+    /**
+     * \brief Marks overlay as changed so it must be composited again
+    */
+    void damage();
+
+    /**
+     * \brief Returns true if overlay changed since the last draw
+    */
+    bool isDamaged() const;
+
+    /**
+     * \brief Forgets overlay damage
+     * \note Call this method before compositing overlay
+    */
+    void reset();
+
+    /**
+     * \brief Draws owner overlay content clipped by owner region
+     * \note If something was placed over the owner, owner is released and invalidated
+     * so it can draw its content as part of the scene
+    */
+    void draw(plug::RenderTarget &target);
+
+    /**
+     * \brief Returns single instance of Overlay
+    */
+    static Overlay &getInstance();
+
+private:
+    Overlay();
+
+    Overlay(const Overlay&) = delete;
+
+    Overlay &operator = (const Overlay&) = delete;
+
+    Widget *owner;          ///< Widget that draws overlay content or nullptr
+    bool is_damaged;        ///< True if overlay changed since the last draw
+};
+
+
+/// Shortcut for getting Overlay instance
+#define OVERLAY Overlay::getInstance()
+
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * \file
+ * \brief Contains render fence implementation
+*/
+
+
+#include "common/assert.hpp"
+#include "widget/render_fence.hpp"
+
+
+// ============================================================================
+
+
+RenderFence::RenderFence() :
+    scene(1), frames(), mutex(), condition() {}
+
+
+void RenderFence::addFrame() {
+    std::lock_guard<std::mutex> guard(mutex);
+    frames.push_back(scene);
+}
+
+
+void RenderFence::startScene() { scene++; }
+
+
+size_t RenderFence::getScene() const { return scene; }
+
+
+bool RenderFence::isReading(size_t scene_) {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    // SCENES ARE FINISHED IN ORDER, SO THE OLDEST FRAME IS ENOUGH
+    return frames.size() && frames[0] <= scene_;
+}
+
+
+void RenderFence::waitScene(size_t scene_) {
+    std::unique_lock<std::mutex> guard(mutex);
+
+    condition.wait(guard, [this, scene_]() { return !frames.size() || frames[0] > scene_; });
+}
+
+
+void RenderFence::removeFrame() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        ASSERT(frames.size(), "No frames are handed to render thread!\n");
+        frames.remove(0);
+    }
+
+    condition.notify_all();
+}
+
+
+void RenderFence::wait() {
+    std::unique_lock<std::mutex> guard(mutex);
+
+    condition.wait(guard, [this]() { return !frames.size(); });
+}
+
+
+RenderFence &RenderFence::getInstance() {
+    static RenderFence render_fence;
+    return render_fence;
+}
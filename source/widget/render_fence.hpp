@@ -0,0 +1,90 @@
+/**
+ * \file
+ * \brief Contains render fence interface
+*/
+
+
+#ifndef _RENDER_FENCE_H_
+#define _RENDER_FENCE_H_
+
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include "common/list.hpp"
+
+
+/**
+ * \brief Counts frames that render thread can still read GPU resources for
+ * \note UI thread records next frame while render thread replays previous one,
+ * so GPU textures are changed or deleted only after wait()
+ * \note Frames are numbered by scenes they show, several frames can show the same scene.
+ * Texture that was drawn in scene can be read by render thread until isReading() of this scene is false
+ * \note This class is a singleton (you must use getInstance to get it)
+*/
+class RenderFence {
+public:
+    /**
+     * \brief Marks that frame of the current scene was handed to render thread
+    */
+    void addFrame();
+
+    /**
+     * \brief Marks that UI thread starts recording new scene
+     * \note Only UI thread can call this method
+    */
+    void startScene();
+
+    /**
+     * \brief Returns number of scene that UI thread records or shows now
+     * \note Only UI thread can call this method
+    */
+    size_t getScene() const;
+
+    /**
+     * \brief Returns true if render thread has frames of this scene or older ones
+    */
+    bool isReading(size_t scene_);
+
+    /**
+     * \brief Waits until render thread finishes all frames of this scene and older ones
+     * \warning Never call this method from render thread
+    */
+    void waitScene(size_t scene_);
+
+    /**
+     * \brief Marks that GPU finished all commands of the oldest handed frame
+    */
+    void removeFrame();
+
+    /**
+     * \brief Waits until render thread has no frames that can use GPU resources
+     * \note Returns immediately if render thread is not used
+     * \warning Never call this method from render thread
+    */
+    void wait();
+
+    /**
+     * \brief Returns single instance of RenderFence
+    */
+    static RenderFence &getInstance();
+
+private:
+    RenderFence();
+
+    RenderFence(const RenderFence&) = delete;
+
+    RenderFence &operator = (const RenderFence&) = delete;
+
+    size_t scene;                           ///< Number of scene that UI thread records now, starts from one so zero means never drawn
+    List<size_t> frames;                    ///< Scenes of frames that are not finished by GPU, the oldest first
+    std::mutex mutex;                       ///< Guards frames counter
+    std::condition_variable condition;      ///< Signals finished frame
+};
+
+
+/// Shortcut for getting RenderFence instance
+#define RENDER_FENCE RenderFence::getInstance()
+
+
+#endif
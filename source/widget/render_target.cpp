@@ -5,8 +5,12 @@
 
 
 #include <cstring>
+#include <SFML/OpenGL.hpp>
 #include "common/assert.hpp"
+#include "widget/render_fence.hpp"
 #include "widget/render_target.hpp"
+#include "widget/texture_cache.hpp"
+#include "common/pixel_convert.hpp"
 #include "common/utils.hpp"
 
 
@@ -19,46 +23,360 @@ bool loadTexture(plug::Texture **texture_ptr, const char *filename) {
     sf::Image image;
     if (!image.loadFromFile(filename)) return false;
 
-    const uint8_t *src = image.getPixelsPtr();
-
     *texture_ptr = new plug::Texture(image.getSize().x, image.getSize().y);
     ASSERT(*texture_ptr, "Failed to allocate texture!\n");
 
     plug::Texture &texture = *(*texture_ptr);
 
-    for (size_t i = 0; i < texture.width * texture.height; i++)
-        texture.data[i] = plug::Color(src[i * 4], src[i * 4 + 1], src[i * 4 + 2], src[i * 4 + 3]);
-    
+    convertRGBAToColors(texture.data, image.getPixelsPtr(), texture.width * texture.height);
+
     return true;
 }
 
 
+void drawRenderTexture(
+    plug::RenderTarget &target, const RenderTexture &texture,
+    const plug::Vec2d &position, const plug::Vec2d &size
+) {
+    plug::Vec2d texture_size = texture.getSize();
+
+    plug::VertexArray array(plug::TriangleFan, 4);
+
+    array[0] = plug::Vertex(position, plug::Color(), plug::Vec2d());
+    array[1] = plug::Vertex(position + plug::Vec2d(0, size.y), plug::Color(), plug::Vec2d(0, texture_size.y));
+    array[2] = plug::Vertex(position + size, plug::Color(), texture_size);
+    array[3] = plug::Vertex(position + plug::Vec2d(size.x, 0), plug::Color(), plug::Vec2d(texture_size.x, 0));
+
+    SFMLTextureTarget *sfml_target = dynamic_cast<SFMLTextureTarget*>(&target);
+
+    if (sfml_target)
+        sfml_target->draw(array, texture.getSFMLTexture());
+    else
+        target.draw(array, texture.getTexture());
+}
+
+
+// ============================================================================
+
+
+RenderTarget::RenderTarget() :
+    is_pending(false), batch(sf::Triangles), batch_texture(nullptr), draw_calls(0),
+    clips(), scratch()
+{
+    getTargets().push_back(this);
+}
+
+
+void RenderTarget::draw(const plug::VertexArray& array) {
+    addToBatch(array, nullptr);
+}
+
+
+void RenderTarget::draw(const plug::VertexArray& array, const plug::Texture& texture) {
+    addToBatch(array, &getGPUTexture(texture));
+}
+
+
+void RenderTarget::draw(const plug::VertexArray& array, const sf::Texture &texture) {
+    addToBatch(array, &texture);
+}
+
+
+void RenderTarget::draw(
+    const sf::VertexBuffer &buffer, const plug::Texture &texture,
+    const plug::Vec2d &position, const plug::Vec2d &scale
+) {
+    const sf::Texture &gpu_texture = getGPUTexture(texture);
+
+    // DRAWS MUST BE SUBMITTED IN ORDER
+    flushBatch();
+
+    sf::RenderStates states(&gpu_texture);
+    states.transform.translate(getSfmlVector2f(position));
+    states.transform.scale(scale.x, scale.y);
+
+    applyScissor();
+    getTarget().draw(buffer, states);
+
+    draw_calls++;
+    is_pending = true;
+}
+
+
+void RenderTarget::clear(plug::Color color) {
+    // EVERYTHING IN BATCH WILL BE OVERWRITTEN ANYWAY
+    discardBatch();
+
+    applyScissor();
+    getTarget().clear(getSfmlColor(color));
+    is_pending = true;
+}
+
+
+void RenderTarget::flush() const {
+    flushBatch();
+}
+
+
+void RenderTarget::flushAll() {
+    // WINDOW TARGET CAN BELONG TO RENDER THREAD, ITS BATCH IS EMPTY ONLY WHEN NO FRAME IS IN FLIGHT
+    RENDER_FENCE.wait();
+
+    List<RenderTarget*> &targets = getTargets();
+
+    for (size_t i = 0; i < targets.size(); i++)
+        targets[i]->flushBatch();
+}
+
+
+plug::Vec2d RenderTarget::getSize() const {
+    return getPlugVector(getTarget().getSize());
+}
+
+
+void RenderTarget::pushClip(const Rect &rect) {
+    Rect clip = intersect(getClip(), alignToPixels(rect));
+
+    // DRAWS IN BATCH MUST NOT BE CLIPPED BY NEW RECTANGLE
+    if (!isEqual(clip, getClip())) flushBatch();
+
+    clips.push_back(clip);
+}
+
+
+void RenderTarget::popClip() {
+    ASSERT(clips.size(), "Clip stack is empty!\n");
+
+    Rect prev_clip = (clips.size() > 1) ? clips[clips.size() - 2] : Rect(plug::Vec2d(), getSize());
+
+    // DRAWS IN BATCH MUST BE CLIPPED BY CURRENT RECTANGLE
+    if (!isEqual(prev_clip, clips.back())) flushBatch();
+
+    clips.pop_back();
+}
+
+
+Rect RenderTarget::getClip() const {
+    if (clips.size()) return clips.back();
+
+    return Rect(plug::Vec2d(), getSize());
+}
+
+
+size_t RenderTarget::getDrawCalls() const { return draw_calls; }
+
+
+void RenderTarget::resetDrawCalls() { draw_calls = 0; }
+
+
+RenderTarget::~RenderTarget() {
+    List<RenderTarget*> &targets = getTargets();
+
+    for (size_t i = 0; i < targets.size(); i++) {
+        if (targets[i] == this) {
+            targets.remove(i);
+            break;
+        }
+    }
+}
+
+
+List<RenderTarget*> &RenderTarget::getTargets() {
+    static List<RenderTarget*> targets;
+    return targets;
+}
+
+
+const sf::Texture &RenderTarget::getGPUTexture(const plug::Texture &texture) {
+    if (!TEXTURE_CACHE.isResident(texture)) {
+        // RETAINED GPU COPY CAN BE IN BATCHES OF OTHER TARGETS, SCRATCH IS USED ONLY BY THIS ONE
+        if (TEXTURE_CACHE.isRetained(texture))
+            flushAll();
+        else
+            flushBatch();
+    }
+
+    return TEXTURE_CACHE.getTexture(texture, scratch);
+}
+
+
+sf::PrimitiveType RenderTarget::getBatchPrimitive(plug::PrimitiveType primitive) {
+    switch (primitive) {
+        case plug::Points:
+            return sf::Points;
+        case plug::Lines:
+        case plug::LineStrip:
+            return sf::Lines;
+        case plug::Triangles:
+        case plug::TriangleStrip:
+        case plug::TriangleFan:
+        case plug::Quads:
+            return sf::Triangles;
+        default:
+            ASSERT(0, "Unknown primitive type!\n");
+    }
+
+    return sf::Triangles;
+}
+
+
+void RenderTarget::addToBatch(const plug::VertexArray &array, const sf::Texture *texture) {
+    sf::PrimitiveType primitive = getBatchPrimitive(array.getPrimitive());
+
+    if (primitive != batch.getPrimitiveType() || texture != batch_texture) {
+        flushBatch();
+        batch.setPrimitiveType(primitive);
+        batch_texture = texture;
+    }
+
+    size_t size = array.getSize();
+
+    // LISTS ARE COPIED AS IS, STRIPS AND FANS ARE SPLIT INTO SEPARATE PRIMITIVES
+
+    switch (array.getPrimitive()) {
+        case plug::Points:
+        case plug::Lines:
+        case plug::Triangles:
+            for (size_t i = 0; i < size; i++)
+                appendVertex(array[i]);
+            break;
+        case plug::LineStrip:
+            for (size_t i = 1; i < size; i++) {
+                appendVertex(array[i - 1]);
+                appendVertex(array[i]);
+            }
+            break;
+        case plug::TriangleStrip:
+            for (size_t i = 2; i < size; i++) {
+                appendVertex(array[i - 2]);
+                appendVertex(array[i - 1]);
+                appendVertex(array[i]);
+            }
+            break;
+        case plug::TriangleFan:
+            for (size_t i = 2; i < size; i++) {
+                appendVertex(array[0]);
+                appendVertex(array[i - 1]);
+                appendVertex(array[i]);
+            }
+            break;
+        case plug::Quads:
+            for (size_t i = 3; i < size; i += 4) {
+                appendVertex(array[i - 3]);
+                appendVertex(array[i - 2]);
+                appendVertex(array[i - 1]);
+                appendVertex(array[i - 3]);
+                appendVertex(array[i - 1]);
+                appendVertex(array[i]);
+            }
+            break;
+        default:
+            ASSERT(0, "Unknown primitive type!\n");
+    }
+}
+
+
+void RenderTarget::appendVertex(const plug::Vertex &vertex) {
+    batch.append(sf::Vertex(
+        getSfmlVector2f(vertex.position),
+        getSfmlColor(vertex.color),
+        getSfmlVector2f(vertex.tex_coords)
+    ));
+}
+
+
+void RenderTarget::flushBatch() const {
+    if (batch.getVertexCount() == 0) return;
+
+    applyScissor();
+    getTarget().draw(batch, sf::RenderStates(batch_texture));
+    batch.clear();
+
+    draw_calls++;
+    is_pending = true;
+}
+
+
+void RenderTarget::discardBatch() {
+    batch.clear();
+    batch_texture = nullptr;
+}
+
+
+void RenderTarget::applyScissor() const {
+    prepareTarget();
+
+    ASSERT(getTarget().setActive(true), "Failed to activate render target!\n");
+
+    if (!clips.size()) {
+        glDisable(GL_SCISSOR_TEST);
+        return;
+    }
+
+    const Rect &clip = clips.back();
+
+    // OPENGL Y AXIS GOES FROM BOTTOM TO TOP
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(
+        GLint(clip.position.x), GLint(getSize().y - clip.getEnd().y),
+        GLsizei(clip.size.x), GLsizei(clip.size.y)
+    );
+}
+
+
+// ============================================================================
+
+
+ClipApplier::ClipApplier(plug::RenderTarget &target_, const Rect &rect) :
+    target(dynamic_cast<ClipTarget*>(&target_))
+{
+    if (target) target->pushClip(rect);
+}
+
+
+ClipApplier::~ClipApplier() {
+    if (target) target->popClip();
+}
+
 // ============================================================================
 
 
 RenderTexture::RenderTexture() :
-    render_texture(), inner_texture(nullptr), is_changed(false) {}
+    RenderTarget(), buffers(), current(0), scenes(), inner_texture(nullptr), is_changed(false) {}
 
 
 void RenderTexture::create(size_t width, size_t height) {
-    ASSERT(render_texture.create(width, height), "Failed to create SFML texture!\n");
+    // OLD CONTENT IS NOT NEEDED, SO BUSY BUFFER IS JUST LEFT TO RENDER THREAD
+    if (RENDER_FENCE.isReading(scenes[current])) swapBuffers();
+
+    ASSERT(buffers[current].create(width, height), "Failed to create SFML texture!\n");
+
+    // PENDING DRAWS BELONG TO THE PREVIOUS TEXTURE
+    discardBatch();
+
+    if (inner_texture) {
+        TEXTURE_CACHE.release(*inner_texture);
+        delete inner_texture;
+    }
     
     inner_texture = new plug::Texture(width, height);
     ASSERT(inner_texture, "Failed to allocate texture!\n");
 
+    TEXTURE_CACHE.retain(*inner_texture);
+
     setChanged(true);
 }
 
 
 const plug::Texture &RenderTexture::getTexture() const {
+    flush();
+
     if (isChanged()) {
-        sf::Image image = render_texture.getTexture().copyToImage();
-        
-        const uint8_t *src = image.getPixelsPtr();
+        sf::Image image = buffers[current].getTexture().copyToImage();
+
+        convertRGBAToColors(inner_texture->data, image.getPixelsPtr(), inner_texture->width * inner_texture->height);
 
-        for (size_t i = 0; i < inner_texture->width * inner_texture->height; i++)
-            inner_texture->data[i] = plug::Color(src[i * 4], src[i * 4 + 1], src[i * 4 + 2], src[i * 4 + 3]);
-        
+        TEXTURE_CACHE.markChanged(*inner_texture);
         setChanged(false);
     }
 
@@ -66,73 +384,64 @@ const plug::Texture &RenderTexture::getTexture() const {
 }
 
 
-void RenderTexture::draw(const plug::VertexArray& array) {
-    sf::VertexArray vertices(
-        sf::PrimitiveType(array.getPrimitive()),
-        array.getSize()
-    );
-
-    for (size_t i = 0; i < array.getSize(); i++) {
-        vertices[i] = sf::Vertex(
-            getSfmlVector2f(array[i].position),
-            getSfmlColor(array[i].color),
-            getSfmlVector2f(array[i].tex_coords)
-        );
-    }
+void RenderTexture::flush() const {
+    RenderTarget::flush();
 
-    render_texture.draw(vertices);
+    if (!is_pending) return;
 
-    render_texture.display();
+    buffers[current].display();
+    is_pending = false;
     setChanged(true);
 }
 
 
-void RenderTexture::draw(const plug::VertexArray& array, const plug::Texture& texture) {
-    static sf::VertexArray vertices;
+const sf::Texture &RenderTexture::getSFMLTexture() const {
+    flush();
 
-    vertices.setPrimitiveType(sf::PrimitiveType(array.getPrimitive()));
-    vertices.resize(array.getSize());
+    // TEXTURE CAN BE RECORDED INTO FRAME OF THE CURRENT SCENE
+    scenes[current] = RENDER_FENCE.getScene();
 
-    for (size_t i = 0; i < array.getSize(); i++) {
-        vertices[i] = sf::Vertex(
-            getSfmlVector2f(array[i].position),
-            getSfmlColor(array[i].color),
-            getSfmlVector2f(array[i].tex_coords)
-        );
-    }
-    
-    static sf::Image image;
-    image.create(texture.width, texture.height, reinterpret_cast<const uint8_t*>(texture.data));
+    return buffers[current].getTexture();
+}
 
-    static sf::Texture tex;
-    tex.loadFromImage(image);
 
-    render_texture.draw(vertices, &tex);
+RenderTexture::~RenderTexture() {
+    // BOTH BUFFERS CAN BE IN FRAMES THAT RENDER THREAD REPLAYS
+    RENDER_FENCE.wait();
 
-    render_texture.display();
-    setChanged(true);
+    if (inner_texture) {
+        TEXTURE_CACHE.release(*inner_texture);
+        delete inner_texture;
+    }
 }
 
 
-void RenderTexture::clear(plug::Color color) {
-    render_texture.clear(getSfmlColor(color));
-    setChanged(true);
-}
+sf::RenderTarget &RenderTexture::getTarget() const { return buffers[current]; }
 
 
-plug::Vec2d RenderTexture::getSize() const {
-    return getPlugVector(render_texture.getSize());
-}
+void RenderTexture::prepareTarget() const {
+    if (!RENDER_FENCE.isReading(scenes[current])) return;
 
+    const sf::RenderTexture &busy = buffers[current];
+    swapBuffers();
 
-const sf::Texture &RenderTexture::getSFMLTexture() const {
-    return render_texture.getTexture();
+    sf::Vector2u size = busy.getSize();
+    if (buffers[current].getSize() != size)
+        ASSERT(buffers[current].create(size.x, size.y), "Failed to create SFML texture!\n");
+
+    // DRAWS CAN CHANGE ONLY PART OF TEXTURE, SO CONTENT OF THE BUSY BUFFER IS COPIED
+    ASSERT(buffers[current].setActive(true), "Failed to activate render target!\n");
+    glDisable(GL_SCISSOR_TEST);
+
+    buffers[current].draw(sf::Sprite(busy.getTexture()), sf::RenderStates(sf::BlendNone));
+    is_pending = true;
 }
 
 
-RenderTexture::~RenderTexture() {
-    if (inner_texture)
-        delete inner_texture;
+void RenderTexture::swapBuffers() const {
+    current = 1 - current;
+
+    RENDER_FENCE.waitScene(scenes[current]);
 }
 
 
@@ -144,3 +453,21 @@ void RenderTexture::setChanged(bool is_changed_) const {
 bool RenderTexture::isChanged() const {
     return is_changed;
 }
+
+
+// ============================================================================
+
+
+WindowTarget::WindowTarget(sf::RenderWindow &window_) :
+    RenderTarget(), window(window_) {}
+
+
+void WindowTarget::display() {
+    flush();
+
+    window.display();
+    is_pending = false;
+}
+
+
+sf::RenderTarget &WindowTarget::getTarget() const { return window; }
@@ -9,6 +9,8 @@
 
 
 #include "SFML/Graphics.hpp"
+#include "common/list.hpp"
+#include "common/rect.hpp"
 #include "standart/Math.h"
 #include "standart/Graphics.h"
 #include "standart/Color.h"
@@ -23,42 +25,86 @@
 bool loadTexture(plug::Texture **texture_ptr, const char *filename);
 
 
-/// plug::Texture for drawing on
-class RenderTexture : public plug::RenderTarget {
+class RenderTexture;
+
+
+/**
+ * \brief Draws render texture content as rectangle
+ * \note If target accepts SFML textures GPU texture is used directly, otherwise content is read back
+*/
+void drawRenderTexture(
+    plug::RenderTarget &target, const RenderTexture &texture,
+    const plug::Vec2d &position, const plug::Vec2d &size
+);
+
+
+/// Target that accepts SFML textures without reading them back
+class SFMLTextureTarget {
 public:
     /**
-     * \brief Creates invalid texture
-     * \warning Call create() first
+     * \brief Draws vertex array using SFML texture directly
+     * \note Texture must stay unchanged until flush
     */
-    RenderTexture();
+    virtual void draw(const plug::VertexArray& array, const sf::Texture &texture) = 0;
 
-    RenderTexture(const RenderTexture&) = delete;
-    
-    RenderTexture &operator = (const RenderTexture&) = delete;
+    virtual ~SFMLTextureTarget() = default;
+};
 
+
+/// Target that can limit draws to rectangle
+class ClipTarget {
+public:
     /**
-     * \brief Creates texture to draw on
-     * \warning Call this method before doing anything
+     * \brief Limits all following draws to intersection of rectangle and current clip
+     * \note Every pushClip() call must be paired with popClip()
     */
-    void create(size_t width, size_t height);
+    virtual void pushClip(const Rect &rect) = 0;
 
     /**
-     * \brief Returns texture
+     * \brief Restores clip that was before the last pushClip()
     */
-    const plug::Texture &getTexture() const;
+    virtual void popClip() = 0;
+
+    virtual ~ClipTarget() = default;
+};
+
+
+/// Render target that draws on SFML target merging compatible draws into one
+class RenderTarget : public plug::RenderTarget, public SFMLTextureTarget, public ClipTarget {
+public:
+    RenderTarget(const RenderTarget&) = delete;
+
+    RenderTarget &operator = (const RenderTarget&) = delete;
 
     /**
      * \brief Draws vertex array
+     * \note Consecutive draws with the same primitive and texture are merged into one
     */
     virtual void draw(const plug::VertexArray& array) override;
 
     /**
      * \brief Draws texture
+     * \note Consecutive draws with the same primitive and texture are merged into one
     */
     virtual void draw(const plug::VertexArray& array, const plug::Texture& texture) override;
 
     /**
-     * \brief Clear texture with specific color
+     * \brief Draws vertex array using SFML texture directly
+     * \note Texture must stay unchanged until flush
+    */
+    virtual void draw(const plug::VertexArray& array, const sf::Texture &texture) override;
+
+    /**
+     * \brief Draws vertex buffer scaled and moved to position
+     * \note Buffer is already on GPU, so it is always a separate draw call
+    */
+    void draw(
+        const sf::VertexBuffer &buffer, const plug::Texture &texture,
+        const plug::Vec2d &position, const plug::Vec2d &scale
+    );
+
+    /**
+     * \brief Clear target with specific color
     */
     virtual void clear(plug::Color color) override;
 
@@ -68,12 +114,181 @@ public:
     virtual void setActive(bool active) override {}
 
     /**
-     * \brief Returns texture size
+     * \brief Submits all pending draws
+    */
+    virtual void flush() const;
+
+    /**
+     * \brief Submits pending draws of every existing target
+     * \note Call it before changing GPU texture that several targets can use
+    */
+    static void flushAll();
+
+    /**
+     * \brief Returns target size
     */
     plug::Vec2d getSize() const;
 
+    /**
+     * \brief Limits all following draws and clears to intersection of rectangle and current clip
+     * \note Every pushClip() call must be paired with popClip()
+    */
+    virtual void pushClip(const Rect &rect) override;
+
+    /**
+     * \brief Restores clip that was before the last pushClip()
+    */
+    virtual void popClip() override;
+
+    /**
+     * \brief Returns rectangle that draws are limited to
+     * \note Returns the whole target if clip stack is empty
+    */
+    Rect getClip() const;
+
+    /**
+     * \brief Returns amount of SFML draw calls since the last reset
+    */
+    size_t getDrawCalls() const;
+
+    /**
+     * \brief Sets draw calls counter to zero
+    */
+    void resetDrawCalls();
+
+    /**
+     * \brief Removes target from the list of existing targets
+    */
+    virtual ~RenderTarget() override;
+
+protected:
+    RenderTarget();
+
+    /**
+     * \brief Returns SFML target to draw on
+    */
+    virtual sf::RenderTarget &getTarget() const = 0;
+
+    /**
+     * \brief Forgets all draws that are not submitted yet
+    */
+    void discardBatch();
+
+    /**
+     * \brief Called before every OpenGL command on target
+     * \note Targets that render thread can read wait for it here
+    */
+    virtual void prepareTarget() const {}
+
+    mutable bool is_pending;                    ///< True if some draws are submitted but not displayed yet
+
+private:
+    /**
+     * \brief Returns primitive type that batch uses for this primitive type
+    */
+    static sf::PrimitiveType getBatchPrimitive(plug::PrimitiveType primitive);
+
+    /**
+     * \brief Returns list of all existing targets
+    */
+    static List<RenderTarget*> &getTargets();
+
+    /**
+     * \brief Returns GPU copy of texture submitting draws that use its previous content
+    */
+    const sf::Texture &getGPUTexture(const plug::Texture &texture);
+
+    /**
+     * \brief Appends vertices to batch converting strips and fans to lists
+     * \note Submits current batch if primitive type or texture differs
+    */
+    void addToBatch(const plug::VertexArray &array, const sf::Texture *texture);
+
+    /**
+     * \brief Appends single vertex to batch
+    */
+    void appendVertex(const plug::Vertex &vertex);
+
+    /**
+     * \brief Draws batch on SFML target and empties it
+    */
+    void flushBatch() const;
+
+    /**
+     * \brief Sets OpenGL scissor state of this target
+     * \note Each target keeps its own scissor even if OpenGL context is shared
+    */
+    void applyScissor() const;
+
+    mutable sf::VertexArray batch;              ///< Vertices that are not drawn yet
+    const sf::Texture *batch_texture;           ///< Texture for all vertices in batch
+    mutable size_t draw_calls;                  ///< Amount of SFML draw calls
+    List<Rect> clips;                           ///< Stack of regions that draws are limited to
+    sf::Texture scratch;                        ///< GPU copy of the last drawn texture that is not retained
+};
+
+
+/// Tool class for temporarily limiting draws to rectangle
+class ClipApplier {
+public:
+    /**
+     * \brief Pushes rectangle to target clip stack
+     * \note Does nothing if target can not clip
+    */
+    ClipApplier(plug::RenderTarget &target_, const Rect &rect);
+
+    ClipApplier(const ClipApplier&) = delete;
+
+    ClipApplier &operator = (const ClipApplier&) = delete;
+
+    /**
+     * \brief Pops rectangle from target clip stack
+    */
+    ~ClipApplier();
+
+private:
+    ClipTarget *target;                         ///< Target that is clipped
+};
+
+
+/**
+ * \brief plug::Texture for drawing on
+ * \note Texture has two SFML buffers. If render thread can read the current one, drawing continues on the other,
+ * so UI thread does not wait for replay
+*/
+class RenderTexture : public RenderTarget {
+public:
+    /**
+     * \brief Creates invalid texture
+     * \warning Call create() first
+    */
+    RenderTexture();
+
+    RenderTexture(const RenderTexture&) = delete;
+    
+    RenderTexture &operator = (const RenderTexture&) = delete;
+
+    /**
+     * \brief Creates texture to draw on
+     * \warning Call this method before doing anything
+    */
+    void create(size_t width, size_t height);
+
+    /**
+     * \brief Returns texture
+     * \note Flushes pending draws
+    */
+    const plug::Texture &getTexture() const;
+
+    /**
+     * \brief Finishes all pending draws
+     * \note Draws are not displayed until flush or readback
+    */
+    virtual void flush() const override;
+
     /**
      * \brief Returns SFML texture directly
+     * \note Flushes pending draws
     */
     const sf::Texture &getSFMLTexture() const;
 
@@ -82,7 +297,21 @@ public:
     */
     virtual ~RenderTexture() override;
 
+protected:
+    virtual sf::RenderTarget &getTarget() const override;
+
+    /**
+     * \brief Switches to the other buffer if render thread can read the current one
+    */
+    virtual void prepareTarget() const override;
+
 private:
+    /**
+     * \brief Makes the other buffer current waiting until render thread stops reading it
+     * \note The other buffer was read in older scene, so usually it is free already
+    */
+    void swapBuffers() const;
+
     /**
      * \brief Sets is_changed value
     */
@@ -93,9 +322,38 @@ private:
     */
     bool isChanged() const;
 
-    sf::RenderTexture render_texture;   ///< Texture to draw on
-    plug::Texture *inner_texture;       ///< Buffer for getTexture optimization
-    mutable bool is_changed;            ///< True if texture has changed
+    mutable sf::RenderTexture buffers[2];       ///< Current buffer to draw on and the one render thread can read
+    mutable size_t current;                     ///< Index of the buffer to draw on
+    mutable size_t scenes[2];                   ///< The last scene each buffer was drawn in
+    plug::Texture *inner_texture;               ///< Buffer for getTexture optimization
+    mutable bool is_changed;                    ///< True if texture has changed
+};
+
+
+/// Render target that draws directly on window without intermediate texture
+class WindowTarget : public RenderTarget {
+public:
+    /**
+     * \brief Creates target for window
+     * \warning Window must live longer than target
+    */
+    WindowTarget(sf::RenderWindow &window_);
+
+    WindowTarget(const WindowTarget&) = delete;
+
+    WindowTarget &operator = (const WindowTarget&) = delete;
+
+    /**
+     * \brief Submits pending draws and shows frame on the screen
+     * \note Window content is undefined after this call, so next frame must be drawn entirely
+    */
+    void display();
+
+protected:
+    virtual sf::RenderTarget &getTarget() const override;
+
+private:
+    sf::RenderWindow &window;                   ///< Window to draw on
 };
 
 
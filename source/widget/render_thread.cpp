@@ -0,0 +1,132 @@
+/**
+ * \file
+ * \brief Contains render thread implementation
+*/
+
+
+#include <SFML/OpenGL.hpp>
+#include <utility>
+#include "common/utils.hpp"
+#include "widget/render_fence.hpp"
+#include "widget/render_thread.hpp"
+#include "widget/transform.hpp"
+
+
+// ============================================================================
+
+
+RenderThread::RenderThread(sf::RenderWindow &window_, WindowTarget &target_) :
+    context(), window(window_), target(target_), overlays(), scenes(), frame_scenes(), scene(0), is_scene_recorded(false),
+    recorded(0), handed(1), replayed(2),
+    is_frame_ready(false), is_stopped(false),
+    mutex(), condition(), thread()
+{
+    // CONTEXT CAN BE ACTIVE ONLY IN ONE THREAD AT A TIME, UI THREAD KEEPS ITS OWN CONTEXT ACTIVE
+    window.setActive(false);
+    context.setActive(true);
+
+    thread = std::thread(&RenderThread::run, this);
+}
+
+
+DisplayList &RenderThread::getSceneList() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        // HANDED AND REPLAYED FRAMES USE AT MOST TWO SCENES, SO ONE OF THREE IS ALWAYS FREE
+        scene = 0;
+        while (scene == frame_scenes[handed] || scene == frame_scenes[replayed]) scene++;
+    }
+
+    // TEXTURES DRAWN FROM NOW ON ARE USED BY FRAMES OF NEW SCENE
+    RENDER_FENCE.startScene();
+
+    is_scene_recorded = true;
+    scenes[scene].reset();
+
+    return scenes[scene];
+}
+
+
+DisplayList &RenderThread::getOverlayList() { return overlays[recorded]; }
+
+
+void RenderThread::submit() {
+    // ALL UPLOADS HAPPEN ON UI THREAD, RENDER THREAD NEVER TOUCHES TEXTURE CACHE
+    if (is_scene_recorded) scenes[scene].uploadTextures();
+    overlays[recorded].uploadTextures();
+
+    is_scene_recorded = false;
+    frame_scenes[recorded] = scene;
+
+    // GLFLUSH DOES NOT MAKE CHANGES VISIBLE IN ANOTHER CONTEXT, GPU MUST FINISH THEM
+    context.setActive(true);
+    glFinish();
+
+    std::unique_lock<std::mutex> guard(mutex);
+
+    // RENDER THREAD IS STILL BUSY WITH THE FRAME BEFORE, ITS LIST CAN NOT BE REUSED YET
+    condition.wait(guard, [this]() { return !is_frame_ready; });
+
+    std::swap(recorded, handed);
+    overlays[recorded].reset();
+
+    RENDER_FENCE.addFrame();
+
+    is_frame_ready = true;
+    condition.notify_all();
+}
+
+
+void RenderThread::run() {
+    window.setActive(true);
+
+    TransformStack stack;
+
+    std::unique_lock<std::mutex> guard(mutex);
+
+    while (true) {
+        condition.wait(guard, [this]() { return is_frame_ready || is_stopped; });
+        if (is_stopped) break;
+
+        // LIST IS TAKEN BY SWAP, SO UI THREAD CAN SUBMIT NEXT FRAME WHILE THIS ONE IS REPLAYED
+        std::swap(handed, replayed);
+
+        is_frame_ready = false;
+        condition.notify_all();
+
+        guard.unlock();
+
+        target.clear(Black);
+        scenes[frame_scenes[replayed]].replay(stack, target);
+        overlays[replayed].replay(stack, target);
+        target.flush();
+
+        // UI THREAD CAN CHANGE TEXTURES AS SOON AS GPU STOPS READING THEM
+        glFinish();
+        RENDER_FENCE.removeFrame();
+
+        target.display();
+
+        guard.lock();
+    }
+
+    window.setActive(false);
+}
+
+
+RenderThread::~RenderThread() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        is_stopped = true;
+    }
+
+    condition.notify_all();
+    thread.join();
+
+    // FRAME THAT WAS NOT PICKED UP IS NEVER REPLAYED
+    if (is_frame_ready) RENDER_FENCE.removeFrame();
+
+    context.setActive(false);
+    window.setActive(true);
+}
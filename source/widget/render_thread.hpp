@@ -0,0 +1,84 @@
+/**
+ * \file
+ * \brief Contains render thread interface
+*/
+
+
+#ifndef _RENDER_THREAD_H_
+#define _RENDER_THREAD_H_
+
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "widget/display_list.hpp"
+
+
+/**
+ * \brief Thread that owns window OpenGL context, replays recorded frames and presents them
+ * \note UI thread records frame into one list, another one waits for render thread and the third one is replayed,
+ * so input handling and recording do not wait for replay and vsync
+ * \note Frame is scene list with overlay list over it. Scene is recorded only when it changes,
+ * frames between such changes replay the same scene list
+ * \note Render thread reads only GPU textures, UI thread waits for RENDER_FENCE before changing or deleting them
+ * and draws on the other buffer of render textures that render thread can read
+*/
+class RenderThread {
+public:
+    /**
+     * \brief Takes window OpenGL context from calling thread and starts render thread
+     * \warning Window and target must live longer than render thread
+    */
+    RenderThread(sf::RenderWindow &window_, WindowTarget &target_);
+
+    RenderThread(const RenderThread&) = delete;
+
+    RenderThread &operator = (const RenderThread&) = delete;
+
+    /**
+     * \brief Returns empty list to record new scene into
+     * \note Next frames show this scene until the method is called again
+    */
+    DisplayList &getSceneList();
+
+    /**
+     * \brief Returns empty list to record overlay of the next frame into
+    */
+    DisplayList &getOverlayList();
+
+    /**
+     * \brief Uploads textures of recorded lists and hands frame to render thread
+     * \note Waits only if the previous handed frame is not picked up by render thread yet
+    */
+    void submit();
+
+    /**
+     * \brief Stops render thread and gives window OpenGL context back to calling thread
+    */
+    ~RenderThread();
+
+private:
+    /**
+     * \brief Replays and presents submitted frames until thread is stopped
+    */
+    void run();
+
+    sf::Context context;                    ///< Context of UI thread, render textures and uploads of UI thread use it
+    sf::RenderWindow &window;               ///< Window which context is owned by render thread
+    WindowTarget &target;                   ///< Target that draws on window
+    DisplayList overlays[3];                ///< Overlays of frame being recorded, frame handed to render thread and frame being replayed
+    DisplayList scenes[3];                  ///< Scene lists, two of them can be used by handed and replayed frames
+    size_t frame_scenes[3];                 ///< Index of scene list that every frame shows
+    size_t scene;                           ///< Index of scene list that next frame shows, used only by UI thread
+    bool is_scene_recorded;                 ///< True if scene was recorded since the last submit, used only by UI thread
+    size_t recorded;                        ///< Index of the frame being recorded, used only by UI thread
+    size_t handed;                          ///< Index of the frame handed to render thread
+    size_t replayed;                        ///< Index of the frame being replayed, used only by render thread
+    bool is_frame_ready;                    ///< True if handed frame is not picked up yet
+    bool is_stopped;                        ///< True if render thread must finish
+    std::mutex mutex;                       ///< Guards handed list index and flags
+    std::condition_variable condition;      ///< Signals frame submit, pick up and stop
+    std::thread thread;                     ///< Render thread
+};
+
+#endif
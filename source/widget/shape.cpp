@@ -8,13 +8,18 @@
 #include <cstring>
 #include "common/assert.hpp"
 #include "widget/shape.hpp"
+#include "widget/tessellation.hpp"
+#include "widget/texture_cache.hpp"
 #include "common/utils.hpp"
 
 
 // ============================================================================
 
 
-const size_t CIRCLE_VERTICES = 30;      ///< Amount of vertices in circle shape
+/**
+ * \brief Blends text color with glyph coverage over background as sf::BlendAlpha does
+*/
+static plug::Color blendGlyphPixel(plug::Color background, plug::Color color, uint8_t coverage);
 
 
 // ============================================================================
@@ -53,8 +58,6 @@ void RectShape::draw(plug::RenderTarget &target) const {
 
     setCenter(array);
     target.draw(array);
-
-    target.draw(array);
     
     if (isEqual(border_thickness, 0)) return;
 
@@ -162,8 +165,7 @@ void CircleShape::setColor(plug::Color color_) { color = color_; }
 
 
 void CircleShape::draw(plug::RenderTarget &target) const {
-    // ONE MORE VERTEX FOR CENTER AND ONE FOR COMPLETING CIRCLE
-    static plug::VertexArray array(plug::TriangleFan, CIRCLE_VERTICES + 2);
+    static plug::VertexArray array(plug::TriangleFan, 0);
 
     setVertexArray(array);
 
@@ -172,8 +174,7 @@ void CircleShape::draw(plug::RenderTarget &target) const {
 
 
 void CircleShape::draw(plug::Canvas &canvas) const {
-    // ONE MORE VERTEX FOR CENTER AND ONE FOR COMPLETING CIRCLE
-    static plug::VertexArray array(plug::TriangleFan, CIRCLE_VERTICES + 2);
+    static plug::VertexArray array(plug::TriangleFan, 0);
 
     setVertexArray(array);
 
@@ -182,27 +183,113 @@ void CircleShape::draw(plug::Canvas &canvas) const {
 
 
 void CircleShape::setVertexArray(plug::VertexArray &array) const {
-    double phi = 0;
+    size_t segments = TESSELLATOR.getSegmentCount(radius);
+    const plug::Vec2d *circle = TESSELLATOR.getUnitCircle(segments);
+
+    // ONE MORE VERTEX FOR CENTER AND ONE FOR COMPLETING CIRCLE
+    array.resize(segments + 2);
 
     array[0] = plug::Vertex(position, color);
 
-    for (size_t i = 1; i <= CIRCLE_VERTICES + 1; i++) {
-        array[i] = plug::Vertex(position + plug::Vec2d(cos(phi), sin(phi)) * radius, color);
-        phi += 6.28319 / CIRCLE_VERTICES;
+    for (size_t i = 0; i <= segments; i++)
+        array[i + 1] = plug::Vertex(position + circle[i] * radius, color);
+}
+
+
+// ============================================================================
+
+
+CapsuleShape::CapsuleShape(const plug::Vec2d &start_, const plug::Vec2d &end_, double radius_, plug::Color color_) :
+    start(start_), end(end_), radius(radius_), color(color_) {}
+
+
+void CapsuleShape::setSegment(const plug::Vec2d &start_, const plug::Vec2d &end_) {
+    start = start_;
+    end = end_;
+}
+
+
+void CapsuleShape::draw(plug::RenderTarget &target) const {
+    static plug::VertexArray array(plug::Triangles, 0);
+
+    setVertexArray(array);
+
+    target.draw(array);
+}
+
+
+void CapsuleShape::draw(plug::Canvas &canvas) const {
+    static plug::VertexArray array(plug::Triangles, 0);
+
+    setVertexArray(array);
+
+    canvas.draw(array);
+}
+
+
+void CapsuleShape::setVertexArray(plug::VertexArray &array) const {
+    plug::Vec2d direction = end - start;
+
+    // ZERO LENGTH CAPSULE IS A CIRCLE, SO ANY DIRECTION FITS
+    if (isEqual(direction.length(), 0)) direction = plug::Vec2d(1, 0);
+    else direction = normalize(direction);
+
+    plug::Vec2d side = plug::Vec2d(-direction.y, direction.x) * radius;
+
+    // RECTANGLE IS TWO TRIANGLES, EACH HALF-DISC HAS HALF OF CIRCLE SEGMENTS
+    array.resize(6 + TESSELLATOR.getSegmentCount(radius) * 3);
+
+    size_t index = 0;
+
+    array[index++] = plug::Vertex(start + side, color);
+    array[index++] = plug::Vertex(start - side, color);
+    array[index++] = plug::Vertex(end - side, color);
+
+    array[index++] = plug::Vertex(start + side, color);
+    array[index++] = plug::Vertex(end - side, color);
+    array[index++] = plug::Vertex(end + side, color);
+
+    index = setHalfDisc(array, index, start, direction * -1);
+    index = setHalfDisc(array, index, end, direction);
+}
+
+
+size_t CapsuleShape::setHalfDisc(plug::VertexArray &array, size_t index, const plug::Vec2d &center, const plug::Vec2d &direction) const {
+    plug::Vec2d side(-direction.y, direction.x);
+
+    size_t segments = TESSELLATOR.getSegmentCount(radius);
+    const plug::Vec2d *circle = TESSELLATOR.getUnitCircle(segments);
+
+    // HALF-DISC GOES FROM ONE SIDE OF THE RECTANGLE TO ANOTHER THROUGH DIRECTION
+    plug::Vec2d prev_point = center + side * radius;
+
+    for (size_t i = 1; i <= segments / 2; i++) {
+        plug::Vec2d point = center + (side * circle[i].x + direction * circle[i].y) * radius;
+
+        array[index++] = plug::Vertex(center, color);
+        array[index++] = plug::Vertex(prev_point, color);
+        array[index++] = plug::Vertex(point, color);
+
+        prev_point = point;
     }
+
+    return index;
 }
 
 
 // ============================================================================
 
 
-TextureShape::TextureShape(const plug::Texture &texture_) :
-    array(plug::TriangleFan, 4), texture(texture_)
+TextureShape::TextureShape(const TextureRegion &region_) :
+    array(plug::TriangleFan, 4), region(region_)
 {
-    array[0].tex_coords = plug::Vec2d();
-    array[1].tex_coords = plug::Vec2d(0, texture.height);
-    array[2].tex_coords = plug::Vec2d(texture.width, texture.height);
-    array[3].tex_coords = plug::Vec2d(texture.width, 0);
+    plug::Vec2d start(region.x, region.y);
+    plug::Vec2d end(region.x + region.width, region.y + region.height);
+
+    array[0].tex_coords = start;
+    array[1].tex_coords = plug::Vec2d(start.x, end.y);
+    array[2].tex_coords = end;
+    array[3].tex_coords = plug::Vec2d(end.x, start.y);
 }
 
 
@@ -212,7 +299,7 @@ void TextureShape::draw(plug::RenderTarget &target, const plug::Vec2d &position,
     array[2].position = position + size;
     array[3].position = plug::Vec2d(position.x + size.x, position.y);
 
-    target.draw(array, texture);
+    target.draw(array, *region.texture);
 }
 
 
@@ -222,7 +309,7 @@ void TextureShape::draw(plug::Canvas &canvas, const plug::Vec2d &position, const
     array[2].position = position + size;
     array[3].position = plug::Vec2d(position.x + size.x, position.y);
 
-    canvas.draw(array, texture);
+    canvas.draw(array, *region.texture);
 }
 
 
@@ -231,32 +318,30 @@ void TextureShape::draw(plug::Canvas &canvas, const plug::Vec2d &position, const
 
 TextShape::TextShape(const sf::Text &text_, const plug::Vec2d &texture_size_) :
     sf_text(text_),
-    texture(texture_size_.x, texture_size_.y),
-    shape(texture),
-    render_texture()
+    texture_size(texture_size_),
+    atlas(GLYPH_CACHE.retain(*text_.getFont(), text_.getCharacterSize())),
+    glyphs(plug::Quads, 0),
+    is_glyphs_valid(false),
+    array(plug::Quads, 0)
 {
-    ASSERT(texture.width && texture.height, "plug::Texture has zero size!\n");
-    ASSERT(render_texture.create(texture.width, texture.height), "Failed to create render texture!\n");
-
-    render();
+    ASSERT(size_t(texture_size.x) && size_t(texture_size.y), "Text box has zero size!\n");
 }
 
 
 TextShape::TextShape(const sf::Text &text_) :
     sf_text(text_),
-    texture(
-        sf_text.getGlobalBounds().width - sf_text.getGlobalBounds().left * 2,
-        sf_text.getGlobalBounds().height - sf_text.getGlobalBounds().top * 2
+    texture_size(
+        size_t(sf_text.getGlobalBounds().width - sf_text.getGlobalBounds().left * 2),
+        size_t(sf_text.getGlobalBounds().height - sf_text.getGlobalBounds().top * 2)
     ),
-    shape(texture),
-    render_texture()
-{    
-    ASSERT(texture.width && texture.height, "plug::Texture has zero size!\n");
-    ASSERT(render_texture.create(texture.width, texture.height), "Failed to create render texture!\n");
+    atlas(GLYPH_CACHE.retain(*text_.getFont(), text_.getCharacterSize())),
+    glyphs(plug::Quads, 0),
+    is_glyphs_valid(false),
+    array(plug::Quads, 0)
+{
+    ASSERT(size_t(texture_size.x) && size_t(texture_size.y), "Text box has zero size!\n");
 
     sf_text.setPosition(-text_.getLocalBounds().left, -text_.getLocalBounds().top);
-
-    render();
 }
 
 
@@ -264,7 +349,7 @@ void TextShape::setTextOffset(const plug::Vec2d &offset) {
     if (getSfmlVector2f(offset) == sf_text.getPosition()) return;
 
     sf_text.setPosition(getSfmlVector2f(offset));
-    render();
+    is_glyphs_valid = false;
 }
 
 
@@ -279,7 +364,7 @@ const sf::Text &TextShape::getText() const {
 
 
 plug::Vec2d TextShape::getTextureSize() const {
-    return plug::Vec2d(texture.width, texture.height);
+    return texture_size;
 }
 
 
@@ -287,43 +372,123 @@ void TextShape::setColor(plug::Color color) {
     if (sf_text.getFillColor() == getSfmlColor(color)) return;
 
     sf_text.setFillColor(getSfmlColor(color));
-    render();
+    is_glyphs_valid = false;
 }
 
 
 void TextShape::setText(const char *str) {
-    // Some fast compare requiered
-    
-    sf_text.setString(str);
-    render();
+    sf::String string(str);
+    if (sf_text.getString() == string) return;
+
+    sf_text.setString(string);
+    is_glyphs_valid = false;
 }
 
 
 void TextShape::draw(plug::RenderTarget &target, const plug::Vec2d &position, const plug::Vec2d &size) {
-    shape.draw(target, position, size);
+    const plug::VertexArray &placed = placeGlyphs(position, size);
+    if (placed.getSize() == 0) return;
+
+    // OUR TARGETS DRAW STRAIGHT FROM FONT TEXTURE, SO GLYPHS ARE NEVER READ BACK
+    SFMLTextureTarget *sfml_target = dynamic_cast<SFMLTextureTarget*>(&target);
+
+    if (sfml_target)
+        sfml_target->draw(placed, atlas.getSFMLTexture());
+    else
+        target.draw(placed, atlas.getTexture());
 }
 
 
 void TextShape::draw(plug::Canvas &canvas, const plug::Vec2d &position, const plug::Vec2d &size) {
-    shape.draw(canvas, position, size);
+    const plug::VertexArray &placed = placeGlyphs(position, size);
+    if (placed.getSize() == 0) return;
+
+    canvas.draw(placed, atlas.getTexture());
 }
 
 
 const plug::Texture TextShape::getTexture() const {
+    updateGlyphs();
+
+    plug::Texture texture(texture_size.x, texture_size.y);
+
+    for (size_t i = 0; i < texture.width * texture.height; i++)
+        texture.data[i] = plug::Color(0, 0, 0, 0);
+
+    const plug::Texture &glyph_texture = atlas.getTexture();
+
+    // QUADS ARE NOT SCALED AND AXIS ALIGNED, SO EVERY GLYPH IS A RECTANGLE COPY
+    for (size_t i = 3; i < glyphs.getSize(); i += 4) {
+        const plug::Vertex &start = glyphs[i - 3];
+        const plug::Vertex &end = glyphs[i - 1];
+
+        long dst_x = lround(start.position.x), dst_y = lround(start.position.y);
+        long src_x = lround(start.tex_coords.x), src_y = lround(start.tex_coords.y);
+        long width = lround(end.tex_coords.x) - src_x, height = lround(end.tex_coords.y) - src_y;
+
+        for (long y = 0; y < height; y++) {
+            for (long x = 0; x < width; x++) {
+                if (dst_x + x < 0 || dst_x + x >= long(texture.width)) continue;
+                if (dst_y + y < 0 || dst_y + y >= long(texture.height)) continue;
+
+                plug::Color glyph_color = glyph_texture.getPixel(src_x + x, src_y + y);
+                plug::Color &pixel = texture.data[(dst_y + y) * texture.width + dst_x + x];
+
+                pixel = blendGlyphPixel(pixel, start.color, glyph_color.a);
+            }
+        }
+    }
+
     return texture;
 }
 
 
-void TextShape::render() {
-    render_texture.draw(sf_text);
-    render_texture.display();
+void TextShape::updateGlyphs() const {
+    if (is_glyphs_valid) return;
 
-    sf::Image image = render_texture.getTexture().copyToImage();
+    glyphs.resize(0);
 
-    const uint8_t *source = image.getPixelsPtr();
+    atlas.appendText(
+        glyphs, sf_text.getString(),
+        getTextOffset(), getPlugColor(sf_text.getFillColor()),
+        Rect(plug::Vec2d(), texture_size)
+    );
 
-    for (size_t i = 0; i < texture.width * texture.height; i++)
-        texture.data[i] = plug::Color(source[i * 4], source[i * 4 + 1], source[i * 4 + 2], source[i * 4 + 3]);
+    is_glyphs_valid = true;
+}
+
+
+const plug::VertexArray &TextShape::placeGlyphs(const plug::Vec2d &position, const plug::Vec2d &size) {
+    updateGlyphs();
+
+    plug::Vec2d scale = size / texture_size;
+
+    array.resize(glyphs.getSize());
+
+    for (size_t i = 0; i < glyphs.getSize(); i++) {
+        array[i] = glyphs[i];
+        array[i].position = position + glyphs[i].position * scale;
+    }
+
+    return array;
+}
+
+
+TextShape::~TextShape() {
+    GLYPH_CACHE.release(atlas);
+}
+
+
+// ============================================================================
+
+
+static plug::Color blendGlyphPixel(plug::Color background, plug::Color color, uint8_t coverage) {
+    unsigned alpha = coverage * color.a / 255;
 
-    render_texture.clear(sf::Color(0));
+    return plug::Color(
+        (color.r * alpha + background.r * (255 - alpha)) / 255,
+        (color.g * alpha + background.g * (255 - alpha)) / 255,
+        (color.b * alpha + background.b * (255 - alpha)) / 255,
+        alpha + background.a * (255 - alpha) / 255
+    );
 }
@@ -8,7 +8,9 @@
 #define _SHAPE_H_
 
 
+#include "widget/glyph_atlas.hpp"
 #include "widget/render_target.hpp"
+#include "widget/texture_atlas.hpp"
 #include "canvas/canvas/canvas.hpp"
 
 
@@ -132,10 +134,54 @@ private:
 };
 
 
+/// Two half-discs joined by a rectangle, shape that circle leaves when moved along segment
+class CapsuleShape {
+public:
+    /**
+     * \brief Constructs capsule shape
+     * \note Start and end are centers of half-discs
+    */
+    CapsuleShape(const plug::Vec2d &start_, const plug::Vec2d &end_, double radius_, plug::Color color_);
+
+    /**
+     * \brief Sets centers of half-discs
+    */
+    void setSegment(const plug::Vec2d &start_, const plug::Vec2d &end_);
+
+    /**
+     * \brief Draws capsule on plug::RenderTarget
+    */
+    void draw(plug::RenderTarget &target) const;
+
+    /**
+     * \brief Draws capsule on plug::Canvas
+    */
+    void draw(plug::Canvas &canvas) const;
+
+private:
+    void setVertexArray(plug::VertexArray &array) const;
+
+    /**
+     * \brief Sets triangles of half-disc that bulges in direction
+     * \return Index of the vertex after the last one set
+    */
+    size_t setHalfDisc(plug::VertexArray &array, size_t index, const plug::Vec2d &center, const plug::Vec2d &direction) const;
+
+    plug::Vec2d start;
+    plug::Vec2d end;
+    double radius;
+    plug::Color color;
+};
+
+
 /// For convenient texture draw
 class TextureShape {
 public:
-    TextureShape(const plug::Texture &texture_);
+    /**
+     * \brief Constructs shape that draws texture region
+     * \note plug::Texture can be passed to draw it entirely
+    */
+    TextureShape(const TextureRegion &region_);
 
     TextureShape(const TextureShape&) = default;
     
@@ -154,38 +200,41 @@ public:
     void draw(plug::Canvas &canvas, const plug::Vec2d &position, const plug::Vec2d &size);
 
     /**
-     * \brief Returns stored texture
+     * \brief Returns texture that contains region
     */
     const plug::Texture &getTexture() const;
 
 private:
     plug::VertexArray array;          ///< Vertex array for texture drawing
-    const plug::Texture &texture;     ///< plug::Texture reference
+    TextureRegion region;             ///< Part of the texture to draw
 };
 
 
-/// For convenient text draw
+/**
+ * \brief For convenient text draw
+ * \note Text is drawn as glyph quads from shared glyph atlas, text outside of the box is clipped
+*/
 class TextShape {
 public:
     /**
      * \brief Constructs text shape
-     * \note plug::Texture should be big enough to hold the text
+     * \note Box should be big enough to hold the text
     */
     TextShape(const sf::Text &text_, const plug::Vec2d &texture_size_);
 
     /**
      * \brief Constructs text shape
-     * \note plug::Texture size is set to text local bounds
+     * \note Box size is set to text local bounds
     */
     TextShape(const sf::Text &text_);
 
     /**
-     * \brief Sets text offset from internal texture
+     * \brief Sets text offset from box top left corner
     */
     void setTextOffset(const plug::Vec2d &offset);
 
     /**
-     * \brief Returns text offset from internal texture
+     * \brief Returns text offset from box top left corner
     */
     plug::Vec2d getTextOffset() const;
 
@@ -199,7 +248,7 @@ public:
     TextShape &operator = (const TextShape&) = delete;
 
     /**
-     * \brief Returns size of internal texture
+     * \brief Returns box size
     */
     plug::Vec2d getTextureSize() const;
 
@@ -215,31 +264,44 @@ public:
 
     /**
      * \brief Draws text on target at specified position with specified size
-     * \note Text scales if size is not equal to texture size
+     * \note Text scales if size is not equal to box size
     */
     void draw(plug::RenderTarget &target, const plug::Vec2d &position, const plug::Vec2d &size);
 
     /**
-     * \brief Draws text on target at specified position with specified size
-     * \note Text scales if size is not equal to texture size
+     * \brief Draws text on canvas at specified position with specified size
+     * \note Text scales if size is not equal to box size
     */
     void draw(plug::Canvas &canvas, const plug::Vec2d &position, const plug::Vec2d &size);
 
     /**
-     * \brief Returns texture
+     * \brief Returns texture of box size with text on it
+     * \note Texture is composed on CPU from glyph atlas
     */
     const plug::Texture getTexture() const;
 
+    /**
+     * \brief Releases glyph atlas
+    */
+    ~TextShape();
+
 private:
     /**
-     * \brief Redraws text on internal texture
+     * \brief Rebuilds glyph quads if text was changed
+    */
+    void updateGlyphs() const;
+
+    /**
+     * \brief Scales glyph quads to specified position and size
     */
-    void render();
+    const plug::VertexArray &placeGlyphs(const plug::Vec2d &position, const plug::Vec2d &size);
 
-    sf::Text sf_text;                   ///< Text itself
-    plug::Texture texture;              ///< Internal texture for handling text image
-    TextureShape shape;                 ///< Shape for convenient texture draw
-    sf::RenderTexture render_texture;   ///< Tool texture for text drawing
+    sf::Text sf_text;                   ///< Text parameters
+    plug::Vec2d texture_size;           ///< Box that text is clipped by
+    GlyphAtlas &atlas;                  ///< Glyphs of text font
+    mutable plug::VertexArray glyphs;   ///< Glyph quads relative to box
+    mutable bool is_glyphs_valid;       ///< False if glyph quads must be rebuilt
+    plug::VertexArray array;            ///< Glyph quads placed for drawing
 };
 
 
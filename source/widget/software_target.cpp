@@ -0,0 +1,474 @@
+/**
+ * \file
+ * \brief Contains software render target implementation
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include "common/assert.hpp"
+#include "common/utils.hpp"
+#include "widget/software_target.hpp"
+
+
+const int64_t SUBPIXEL_SCALE = 256;     ///< Amount of fixed point steps in one pixel
+const long TILE_SIZE = 32;              ///< Side of square tile in pixels
+
+
+static_assert(TEXTURE_TILE_SIZE % TILE_SIZE == 0, "Raster tile must not cross texture tiles!\n");
+
+
+/**
+ * \brief Converts coordinate to fixed point
+*/
+static int64_t toFixed(double value);
+
+
+/**
+ * \brief Mixes vertex colors using barycentric weights of the second and the third vertex
+*/
+static plug::Color mixColors(
+    const plug::Color &a, const plug::Color &b, const plug::Color &c,
+    double weight_b, double weight_c
+);
+
+
+/**
+ * \brief Returns texel containing texture coordinates, coordinates outside of texture are clamped
+*/
+static plug::Color sampleTexture(const plug::Texture &texture, const plug::Vec2d &tex_coords);
+
+
+/**
+ * \brief Multiplies texel by vertex color like SFML does
+*/
+static plug::Color modulateColor(const plug::Color &texel, const plug::Color &color);
+
+
+/**
+ * \brief Draws color over pixel using alpha blending
+*/
+static void blendPixel(plug::Color &pixel, const plug::Color &color);
+
+
+// ============================================================================
+
+
+SoftwareRenderTarget::SoftwareRenderTarget() :
+    pixels(), clips(), flat_texture(nullptr), flat_stamps() {}
+
+
+void SoftwareRenderTarget::create(size_t width, size_t height) {
+    ASSERT(!clips.size(), "Target is recreated while clipped!\n");
+
+    pixels = TiledTexture(width, height, plug::Color(0, 0, 0, 0));
+
+    releaseTexture();
+}
+
+
+void SoftwareRenderTarget::draw(const plug::VertexArray& array) {
+    drawPrimitives(array, nullptr);
+}
+
+
+void SoftwareRenderTarget::draw(const plug::VertexArray& array, const plug::Texture& texture) {
+    drawPrimitives(array, &texture);
+}
+
+
+void SoftwareRenderTarget::clear(plug::Color color) {
+    Bounds clip = getClipBounds();
+
+    if (clip.x0 >= clip.x1 || clip.y0 >= clip.y1) return;
+
+    pixels.fill(clip.x0, clip.y0, clip.x1, clip.y1, color);
+}
+
+
+void SoftwareRenderTarget::pushClip(const Rect &rect) {
+    clips.push_back(intersect(getClip(), alignToPixels(rect)));
+}
+
+
+void SoftwareRenderTarget::popClip() {
+    ASSERT(clips.size(), "Clip stack is empty!\n");
+
+    clips.pop_back();
+}
+
+
+Rect SoftwareRenderTarget::getClip() const {
+    if (clips.size()) return clips.back();
+
+    return Rect(plug::Vec2d(), getSize());
+}
+
+
+plug::Vec2d SoftwareRenderTarget::getSize() const {
+    return plug::Vec2d(pixels.getWidth(), pixels.getHeight());
+}
+
+
+const plug::Texture &SoftwareRenderTarget::getTexture() const {
+    if (!flat_texture) {
+        flat_texture = new plug::Texture(pixels.getWidth(), pixels.getHeight());
+        ASSERT(flat_texture, "Failed to allocate texture!\n");
+
+        // ZERO STAMP NEVER MATCHES, SO ALL TILES ARE COPIED
+        flat_stamps = List<size_t>(pixels.getColumns() * pixels.getRows(), 0);
+    }
+
+    for (size_t row = 0; row < pixels.getRows(); row++) {
+        for (size_t column = 0; column < pixels.getColumns(); column++) {
+            size_t stamp = pixels.getStamp(column, row);
+            if (flat_stamps[row * pixels.getColumns() + column] == stamp) continue;
+
+            flat_stamps[row * pixels.getColumns() + column] = stamp;
+
+            size_t x = column * TEXTURE_TILE_SIZE, y = row * TEXTURE_TILE_SIZE;
+            size_t width = std::min(TEXTURE_TILE_SIZE, pixels.getWidth() - x);
+            size_t height = std::min(TEXTURE_TILE_SIZE, pixels.getHeight() - y);
+
+            for (size_t i = 0; i < height; i++)
+                pixels.copyTo(flat_texture->data + (y + i) * flat_texture->width + x, x, y + i, width, 1);
+        }
+    }
+
+    return *flat_texture;
+}
+
+
+void SoftwareRenderTarget::releaseTexture() {
+    if (flat_texture) delete flat_texture;
+
+    flat_texture = nullptr;
+    flat_stamps = List<size_t>();
+}
+
+
+const TiledTexture &SoftwareRenderTarget::getPixels() const { return pixels; }
+
+
+TiledTexture &SoftwareRenderTarget::getPixels() { return pixels; }
+
+
+void SoftwareRenderTarget::setPixels(const TiledTexture &texture) {
+    ASSERT(
+        texture.getWidth() == pixels.getWidth() && texture.getHeight() == pixels.getHeight(),
+        "Texture size differs from target size!\n"
+    );
+
+    pixels = texture;
+}
+
+
+plug::Color SoftwareRenderTarget::getPixel(size_t x, size_t y) const {
+    return pixels.getPixel(x, y);
+}
+
+
+void SoftwareRenderTarget::setPixel(size_t x, size_t y, const plug::Color &color) {
+    pixels.setPixel(x, y, color);
+}
+
+
+SoftwareRenderTarget::Bounds SoftwareRenderTarget::getClipBounds() const {
+    // CLIPS ARE ALIGNED TO PIXELS WHEN PUSHED
+    Rect clip = getClip();
+
+    return {
+        lround(clip.position.x), lround(clip.position.y),
+        lround(clip.position.x + clip.size.x), lround(clip.position.y + clip.size.y)
+    };
+}
+
+
+void SoftwareRenderTarget::drawPrimitives(const plug::VertexArray &array, const plug::Texture *texture) {
+    size_t size = array.getSize();
+
+    switch (array.getPrimitive()) {
+        case plug::Points:
+            for (size_t i = 0; i < size; i++)
+                drawPoint(array[i], texture);
+            break;
+
+        case plug::Lines:
+            for (size_t i = 1; i < size; i += 2)
+                drawLine(array[i - 1], array[i], texture);
+            break;
+
+        case plug::LineStrip:
+            for (size_t i = 1; i < size; i++)
+                drawLine(array[i - 1], array[i], texture);
+            break;
+
+        case plug::Triangles:
+            for (size_t i = 2; i < size; i += 3)
+                drawTriangle(array[i - 2], array[i - 1], array[i], texture);
+            break;
+
+        case plug::TriangleStrip:
+            for (size_t i = 2; i < size; i++)
+                drawTriangle(array[i - 2], array[i - 1], array[i], texture);
+            break;
+
+        case plug::TriangleFan:
+            for (size_t i = 2; i < size; i++)
+                drawTriangle(array[0], array[i - 1], array[i], texture);
+            break;
+
+        case plug::Quads:
+            // QUADS ARE SPLIT BY THE SAME DIAGONAL AS OPENGL DOES
+            for (size_t i = 3; i < size; i += 4) {
+                drawTriangle(array[i - 3], array[i - 2], array[i - 1], texture);
+                drawTriangle(array[i - 3], array[i - 1], array[i], texture);
+            }
+            break;
+
+        default:
+            ASSERT(0, "Unknown primitive type!\n");
+            break;
+    }
+}
+
+
+void SoftwareRenderTarget::drawPoint(const plug::Vertex &vertex, const plug::Texture *texture) {
+    Bounds clip = getClipBounds();
+
+    long x = floor(vertex.position.x), y = floor(vertex.position.y);
+    if (x < clip.x0 || x >= clip.x1 || y < clip.y0 || y >= clip.y1) return;
+
+    shadePixel(*pixels.editRow(x, y), vertex.color, vertex.tex_coords, texture);
+}
+
+
+void SoftwareRenderTarget::drawLine(const plug::Vertex &start, const plug::Vertex &end, const plug::Texture *texture) {
+    Bounds clip = getClipBounds();
+
+    plug::Vec2d delta = end.position - start.position;
+    plug::Vec2d tex_delta = end.tex_coords - start.tex_coords;
+
+    // ONE PIXEL PER STEP ALONG THE MAJOR AXIS, THE LAST PIXEL BELONGS TO THE NEXT LINE
+    long steps = lround(std::max(fabs(delta.x), fabs(delta.y)));
+
+    for (long i = 0; i < steps; i++) {
+        double t = double(i) / steps;
+        plug::Vec2d position = start.position + delta * t;
+
+        long x = floor(position.x), y = floor(position.y);
+        if (x < clip.x0 || x >= clip.x1 || y < clip.y0 || y >= clip.y1) continue;
+
+        shadePixel(
+            *pixels.editRow(x, y),
+            mixColors(start.color, end.color, end.color, t, 0),
+            start.tex_coords + tex_delta * t,
+            texture
+        );
+    }
+}
+
+
+void SoftwareRenderTarget::drawTriangle(
+    const plug::Vertex &a, const plug::Vertex &b, const plug::Vertex &c,
+    const plug::Texture *texture
+) {
+    const plug::Vertex *vertices[3] = {&a, &b, &c};
+    int64_t x[3] = {}, y[3] = {};
+
+    for (size_t i = 0; i < 3; i++) {
+        x[i] = toFixed(vertices[i]->position.x);
+        y[i] = toFixed(vertices[i]->position.y);
+    }
+
+    int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0) return;
+
+    // EDGE FUNCTIONS ARE POSITIVE INSIDE ONLY FOR ONE WINDING, SO THE OTHER ONE IS FLIPPED
+    if (area < 0) {
+        std::swap(vertices[1], vertices[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        area = -area;
+    }
+
+    Bounds clip = getClipBounds();
+
+    Bounds box = {
+        std::max(clip.x0, long(floor(std::min({a.position.x, b.position.x, c.position.x})))),
+        std::max(clip.y0, long(floor(std::min({a.position.y, b.position.y, c.position.y})))),
+        std::min(clip.x1, long(ceil(std::max({a.position.x, b.position.x, c.position.x})))),
+        std::min(clip.y1, long(ceil(std::max({a.position.y, b.position.y, c.position.y}))))
+    };
+
+    if (box.x0 >= box.x1 || box.y0 >= box.y1) return;
+
+    // EDGE i IS OPPOSITE TO VERTEX i, ITS FUNCTION IS ZERO ON THE EDGE AND AREA AT THE VERTEX
+    Edge edges[3] = {};
+    int64_t origin[3] = {};
+
+    int64_t center_x = box.x0 * SUBPIXEL_SCALE + SUBPIXEL_SCALE / 2;
+    int64_t center_y = box.y0 * SUBPIXEL_SCALE + SUBPIXEL_SCALE / 2;
+
+    for (size_t i = 0; i < 3; i++) {
+        size_t j = (i + 1) % 3, k = (i + 2) % 3;
+
+        int64_t step_x = y[j] - y[k], step_y = x[k] - x[j];
+
+        // PIXELS EXACTLY ON THE EDGE ARE DRAWN ONLY FOR TOP AND LEFT EDGES
+        bool is_top_left = step_x > 0 || (step_x == 0 && step_y > 0);
+
+        edges[i] = {step_x * SUBPIXEL_SCALE, step_y * SUBPIXEL_SCALE, is_top_left ? 0 : -1};
+        origin[i] = step_y * (center_y - y[j]) + step_x * (center_x - x[j]) + edges[i].bias;
+    }
+
+    bool is_flat = !texture && isEqual(a.color, b.color) && isEqual(a.color, c.color);
+
+    double inv_area = 1.0 / area;
+
+    // TILES ARE ALIGNED TO THE GRID, SO EACH OF THEM LIES INSIDE ONE TEXTURE TILE
+    for (long tile_y = box.y0 - box.y0 % TILE_SIZE; tile_y < box.y1; tile_y += TILE_SIZE) {
+        for (long tile_x = box.x0 - box.x0 % TILE_SIZE; tile_x < box.x1; tile_x += TILE_SIZE) {
+            Bounds tile = {
+                std::max(tile_x, box.x0), std::max(tile_y, box.y0),
+                std::min(tile_x + TILE_SIZE, box.x1), std::min(tile_y + TILE_SIZE, box.y1)
+            };
+
+            int64_t tile_origin[3] = {};
+            bool is_empty = false, is_full = true;
+
+            // FUNCTIONS ARE LINEAR, SO THEIR EXTREMES ON THE TILE ARE AT CORNERS
+            for (size_t i = 0; i < 3; i++) {
+                tile_origin[i] = origin[i] + (tile.x0 - box.x0) * edges[i].dx + (tile.y0 - box.y0) * edges[i].dy;
+
+                int64_t span_x = (tile.x1 - 1 - tile.x0) * edges[i].dx;
+                int64_t span_y = (tile.y1 - 1 - tile.y0) * edges[i].dy;
+
+                int64_t low = tile_origin[i] + std::min<int64_t>(span_x, 0) + std::min<int64_t>(span_y, 0);
+                int64_t high = tile_origin[i] + std::max<int64_t>(span_x, 0) + std::max<int64_t>(span_y, 0);
+
+                if (high < 0) is_empty = true;
+                if (low < 0) is_full = false;
+            }
+
+            if (is_empty) continue;
+
+            for (long py = tile.y0; py < tile.y1; py++) {
+                int64_t row[3] = {};
+                for (size_t i = 0; i < 3; i++)
+                    row[i] = tile_origin[i] + (py - tile.y0) * edges[i].dy;
+
+                // SHARED TILE IS COPIED ONLY WHEN THE FIRST PIXEL IS DRAWN ON IT
+                plug::Color *line = nullptr;
+
+                for (long px = tile.x0; px < tile.x1; px++) {
+                    // PIXEL IS INSIDE IF NO FUNCTION HAS SIGN BIT SET
+                    if (is_full || (row[0] | row[1] | row[2]) >= 0) {
+                        if (!line) line = pixels.editRow(tile.x0, py);
+
+                        if (is_flat)
+                            blendPixel(line[px - tile.x0], a.color);
+                        else {
+                            // BIAS ONLY DECIDES COVERAGE, WEIGHTS USE EXACT FUNCTION VALUES
+                            double weight_1 = (row[1] - edges[1].bias) * inv_area;
+                            double weight_2 = (row[2] - edges[2].bias) * inv_area;
+                            double weight_0 = 1 - weight_1 - weight_2;
+
+                            shadePixel(
+                                line[px - tile.x0],
+                                mixColors(
+                                    vertices[0]->color, vertices[1]->color, vertices[2]->color,
+                                    weight_1, weight_2
+                                ),
+                                vertices[0]->tex_coords * weight_0 +
+                                vertices[1]->tex_coords * weight_1 +
+                                vertices[2]->tex_coords * weight_2,
+                                texture
+                            );
+                        }
+                    }
+
+                    row[0] += edges[0].dx;
+                    row[1] += edges[1].dx;
+                    row[2] += edges[2].dx;
+                }
+            }
+        }
+    }
+}
+
+
+void SoftwareRenderTarget::shadePixel(
+    plug::Color &pixel,
+    const plug::Color &color, const plug::Vec2d &tex_coords,
+    const plug::Texture *texture
+) {
+    plug::Color source = texture ? modulateColor(sampleTexture(*texture, tex_coords), color) : color;
+
+    blendPixel(pixel, source);
+}
+
+
+SoftwareRenderTarget::~SoftwareRenderTarget() {
+    if (flat_texture) delete flat_texture;
+}
+
+
+// ============================================================================
+
+
+static int64_t toFixed(double value) {
+    return llround(value * SUBPIXEL_SCALE);
+}
+
+
+static plug::Color mixColors(
+    const plug::Color &a, const plug::Color &b, const plug::Color &c,
+    double weight_b, double weight_c
+) {
+    double weight_a = 1 - weight_b - weight_c;
+
+    // PIXEL CENTERS ON EDGES CAN GIVE WEIGHTS SLIGHTLY OUTSIDE OF [0, 1]
+    auto mix = [=](uint8_t value_a, uint8_t value_b, uint8_t value_c) {
+        double value = value_a * weight_a + value_b * weight_b + value_c * weight_c;
+        return uint8_t(std::min(std::max(lround(value), 0L), 255L));
+    };
+
+    return plug::Color(mix(a.r, b.r, c.r), mix(a.g, b.g, c.g), mix(a.b, b.b, c.b), mix(a.a, b.a, c.a));
+}
+
+
+static plug::Color sampleTexture(const plug::Texture &texture, const plug::Vec2d &tex_coords) {
+    long x = std::min(std::max(long(floor(tex_coords.x)), 0L), long(texture.width) - 1);
+    long y = std::min(std::max(long(floor(tex_coords.y)), 0L), long(texture.height) - 1);
+
+    return texture.data[y * texture.width + x];
+}
+
+
+static plug::Color modulateColor(const plug::Color &texel, const plug::Color &color) {
+    return plug::Color(
+        (texel.r * color.r + 127) / 255, (texel.g * color.g + 127) / 255,
+        (texel.b * color.b + 127) / 255, (texel.a * color.a + 127) / 255
+    );
+}
+
+
+static void blendPixel(plug::Color &pixel, const plug::Color &color) {
+    if (color.a == 255) {
+        pixel = color;
+        return;
+    }
+
+    if (color.a == 0) return;
+
+    unsigned inverse = 255 - color.a;
+
+    // SAME AS SFML BLEND ALPHA: SOURCE ALPHA IS ADDED TO THE REMAINING DESTINATION ALPHA
+    pixel = plug::Color(
+        (color.r * color.a + pixel.r * inverse + 127) / 255,
+        (color.g * color.a + pixel.g * inverse + 127) / 255,
+        (color.b * color.a + pixel.b * inverse + 127) / 255,
+        color.a + (pixel.a * inverse + 127) / 255
+    );
+}
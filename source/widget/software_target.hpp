@@ -0,0 +1,180 @@
+/**
+ * \file
+ * \brief Contains software render target interface
+*/
+
+
+#ifndef _SOFTWARE_TARGET_H_
+#define _SOFTWARE_TARGET_H_
+
+
+#include <cstdint>
+#include "widget/render_target.hpp"
+#include "widget/tiled_texture.hpp"
+
+
+/**
+ * \brief Render target that rasterizes vertex arrays on CPU into its own texture
+ * \note Uses OpenGL rules, so output matches SFML targets: pixel centers are sampled,
+ * top and left triangle edges are inclusive, textures are not smoothed and colors are alpha blended
+ * \note Triangles are processed by tiles, fully covered tiles are filled without edge tests
+ * \note Pixels are stored in shared tiles, so copies of target content are cheap
+*/
+class SoftwareRenderTarget : public plug::RenderTarget, public ClipTarget {
+public:
+    /**
+     * \brief Creates empty target
+     * \warning Call create() first
+    */
+    SoftwareRenderTarget();
+
+    SoftwareRenderTarget(const SoftwareRenderTarget&) = delete;
+
+    SoftwareRenderTarget &operator = (const SoftwareRenderTarget&) = delete;
+
+    /**
+     * \brief Allocates transparent pixels of the target
+     * \note Previous content is lost
+    */
+    void create(size_t width, size_t height);
+
+    /**
+     * \brief Rasterizes vertex array using vertex colors
+    */
+    virtual void draw(const plug::VertexArray& array) override;
+
+    /**
+     * \brief Rasterizes vertex array using texture modulated by vertex colors
+    */
+    virtual void draw(const plug::VertexArray& array, const plug::Texture& texture) override;
+
+    /**
+     * \brief Fills clip region with color without blending
+    */
+    virtual void clear(plug::Color color) override;
+
+    /**
+     * \brief Deprecated method
+    */
+    virtual void setActive(bool active) override {}
+
+    /**
+     * \brief Limits all following draws and clears to intersection of rectangle and current clip
+     * \note Every pushClip() call must be paired with popClip()
+    */
+    virtual void pushClip(const Rect &rect) override;
+
+    /**
+     * \brief Restores clip that was before the last pushClip()
+    */
+    virtual void popClip() override;
+
+    /**
+     * \brief Returns rectangle that draws are limited to
+     * \note Returns the whole target if clip stack is empty
+    */
+    Rect getClip() const;
+
+    /**
+     * \brief Returns target size
+    */
+    plug::Vec2d getSize() const;
+
+    /**
+     * \brief Returns target pixels as one continuous texture
+     * \note Texture is assembled on the first call, later calls copy only tiles changed since then
+    */
+    const plug::Texture &getTexture() const;
+
+    /**
+     * \brief Frees continuous copy of pixels made by getTexture()
+     * \warning References returned by getTexture() become invalid
+    */
+    void releaseTexture();
+
+    /**
+     * \brief Returns tiled target pixels without assembling them
+    */
+    const TiledTexture &getPixels() const;
+
+    /**
+     * \brief Returns tiled target pixels for writing without draws
+     * \note Clips do not apply to direct writes
+    */
+    TiledTexture &getPixels();
+
+    /**
+     * \brief Replaces target pixels sharing tiles with texture
+     * \warning Texture must have the same size as the target
+    */
+    void setPixels(const TiledTexture &texture);
+
+    /**
+     * \brief Returns pixel color
+    */
+    plug::Color getPixel(size_t x, size_t y) const;
+
+    /**
+     * \brief Sets pixel color without blending
+    */
+    void setPixel(size_t x, size_t y, const plug::Color &color);
+
+    /**
+     * \brief Deletes assembled texture
+    */
+    virtual ~SoftwareRenderTarget() override;
+
+private:
+    /// Pixel region [x0, x1) x [y0, y1)
+    struct Bounds {
+        long x0;    ///< Left column
+        long y0;    ///< Top row
+        long x1;    ///< Column after the right one
+        long y1;    ///< Row after the bottom one
+    };
+
+    /// Triangle edge function in fixed point coordinates
+    struct Edge {
+        int64_t dx;     ///< Function increment for the next column
+        int64_t dy;     ///< Function increment for the next row
+        int64_t bias;   ///< Makes pixels on top and left edges inside
+    };
+
+    /**
+     * \brief Returns pixels inside current clip
+    */
+    Bounds getClipBounds() const;
+
+    /**
+     * \brief Splits vertex array into points, lines and triangles
+    */
+    void drawPrimitives(const plug::VertexArray &array, const plug::Texture *texture);
+
+    /**
+     * \brief Rasterizes single pixel containing vertex
+    */
+    void drawPoint(const plug::Vertex &vertex, const plug::Texture *texture);
+
+    /**
+     * \brief Rasterizes line without its last pixel
+    */
+    void drawLine(const plug::Vertex &start, const plug::Vertex &end, const plug::Texture *texture);
+
+    /**
+     * \brief Rasterizes triangle tile by tile
+    */
+    void drawTriangle(const plug::Vertex &a, const plug::Vertex &b, const plug::Vertex &c, const plug::Texture *texture);
+
+    /**
+     * \brief Blends shaded color into pixel
+    */
+    void shadePixel(plug::Color &pixel, const plug::Color &color, const plug::Vec2d &tex_coords, const plug::Texture *texture);
+
+    TiledTexture pixels;                    ///< Target content
+    List<Rect> clips;                       ///< Stack of regions that draws are limited to
+    mutable plug::Texture *flat_texture;    ///< Continuous copy of pixels or nullptr
+    mutable List<size_t> flat_stamps;       ///< Stamps of tiles that are copied to flat_texture
+};
+
+
+#endif
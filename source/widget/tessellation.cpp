@@ -0,0 +1,65 @@
+/**
+ * \file
+ * \brief Contains circle tessellation implementation
+*/
+
+
+#include <cmath>
+#include "common/assert.hpp"
+#include "widget/tessellation.hpp"
+
+
+const double MAX_ERROR = 0.25;          ///< Maximal distance between circle and its polygon in pixels
+const size_t MIN_SEGMENTS = 8;          ///< Amount of segments in the smallest circle
+
+
+// ============================================================================
+
+
+Tessellator::Tessellator() : tables() {}
+
+
+size_t Tessellator::getSegmentCount(double radius) const {
+    // POLYGON ERROR IS R * (1 - COS(PI / N)) ~ R * (PI / N)^2 / 2
+    double required = M_PI * sqrt(radius / (2 * MAX_ERROR));
+
+    size_t segments = MIN_SEGMENTS;
+    for (size_t i = 1; i < TABLE_COUNT && segments < required; i++)
+        segments *= 2;
+
+    return segments;
+}
+
+
+const plug::Vec2d *Tessellator::getUnitCircle(size_t segments) {
+    size_t index = 0;
+    while (index < TABLE_COUNT && (MIN_SEGMENTS << index) != segments) index++;
+
+    ASSERT(index < TABLE_COUNT, "Unsupported segment count!\n");
+
+    if (!tables[index]) {
+        tables[index] = new plug::Vec2d[segments + 1];
+        ASSERT(tables[index], "Failed to allocate circle table!\n");
+
+        for (size_t i = 0; i < segments; i++) {
+            double phi = 2 * M_PI * i / segments;
+            tables[index][i] = plug::Vec2d(cos(phi), sin(phi));
+        }
+
+        tables[index][segments] = tables[index][0];
+    }
+
+    return tables[index];
+}
+
+
+Tessellator &Tessellator::getInstance() {
+    static Tessellator tessellator;
+    return tessellator;
+}
+
+
+Tessellator::~Tessellator() {
+    for (size_t i = 0; i < TABLE_COUNT; i++)
+        delete[] tables[i];
+}
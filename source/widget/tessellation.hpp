@@ -0,0 +1,63 @@
+/**
+ * \file
+ * \brief Contains circle tessellation interface
+*/
+
+
+#ifndef _TESSELLATION_H_
+#define _TESSELLATION_H_
+
+
+#include <cstddef>
+#include "standart/Math.h"
+
+
+/**
+ * \brief Chooses how many segments circles are split into and keeps unit circle tables for them
+ * \note Segment counts are powers of two, so half and quarter arcs start and end at table points
+ * \note This class is a singleton (you must use getInstance to get it)
+*/
+class Tessellator {
+public:
+    /**
+     * \brief Returns amount of segments for circle of radius in pixels
+     * \note Distance between circle and its polygon does not exceed maximal error
+    */
+    size_t getSegmentCount(double radius) const;
+
+    /**
+     * \brief Returns unit circle points from angle 0 counterclockwise
+     * \note Table has segments + 1 points, the last one is equal to the first
+     * \warning Segments must be value returned by getSegmentCount()
+    */
+    const plug::Vec2d *getUnitCircle(size_t segments);
+
+    /**
+     * \brief Returns single instance of Tessellator
+    */
+    static Tessellator &getInstance();
+
+    /**
+     * \brief Frees all tables
+    */
+    ~Tessellator();
+
+private:
+    /// Amount of different segment counts
+    static const size_t TABLE_COUNT = 8;
+
+    Tessellator();
+
+    Tessellator(const Tessellator&) = delete;
+
+    Tessellator &operator = (const Tessellator&) = delete;
+
+    plug::Vec2d *tables[TABLE_COUNT];       ///< Unit circle tables, computed on first use
+};
+
+
+/// Shortcut for getting Tessellator instance
+#define TESSELLATOR Tessellator::getInstance()
+
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * \file
+ * \brief Contains texture atlas implementation
+*/
+
+
+#include <cstring>
+#include "common/assert.hpp"
+#include "widget/texture_atlas.hpp"
+#include "widget/texture_cache.hpp"
+
+
+const size_t ATLAS_WIDTH = 1024;    ///< Minimal atlas width
+const size_t ATLAS_PADDING = 1;     ///< Empty pixels between regions
+
+
+// ============================================================================
+
+
+TextureRegion::TextureRegion(const plug::Texture &texture_) :
+    texture(&texture_), x(0), y(0), width(texture_.width), height(texture_.height) {}
+
+
+TextureRegion::TextureRegion(
+    const plug::Texture &texture_,
+    size_t x_, size_t y_, size_t width_, size_t height_
+) :
+    texture(&texture_), x(x_), y(y_), width(width_), height(height_)
+{
+    ASSERT(x + width <= texture->width && y + height <= texture->height, "Region is out of texture!\n");
+}
+
+
+// ============================================================================
+
+
+TextureAtlas::TextureAtlas(const List<plug::Texture*> &textures) :
+    texture(nullptr), regions()
+{
+    size_t atlas_width = ATLAS_WIDTH;
+
+    for (size_t i = 0; i < textures.size(); i++)
+        if (textures[i] && textures[i]->width + ATLAS_PADDING > atlas_width)
+            atlas_width = textures[i]->width + ATLAS_PADDING;
+
+    // TALLEST TEXTURES ARE PLACED FIRST SO SHELVES WASTE LESS SPACE
+    List<size_t> order;
+    for (size_t i = 0; i < textures.size(); i++)
+        if (textures[i]) order.push_back(i);
+
+    for (size_t i = 1; i < order.size(); i++) {
+        size_t curr = order[i], j = i;
+
+        for (; j > 0 && textures[order[j - 1]]->height < textures[curr]->height; j--)
+            order[j] = order[j - 1];
+
+        order[j] = curr;
+    }
+
+    List<plug::Vec2d> positions(textures.size(), plug::Vec2d());
+
+    size_t shelf_x = 0, shelf_y = 0, shelf_height = 0;
+
+    for (size_t i = 0; i < order.size(); i++) {
+        const plug::Texture &curr = *textures[order[i]];
+
+        if (shelf_x + curr.width + ATLAS_PADDING > atlas_width) {
+            shelf_y += shelf_height;
+            shelf_x = 0;
+            shelf_height = 0;
+        }
+
+        positions[order[i]] = plug::Vec2d(shelf_x, shelf_y);
+
+        shelf_x += curr.width + ATLAS_PADDING;
+        if (curr.height + ATLAS_PADDING > shelf_height) shelf_height = curr.height + ATLAS_PADDING;
+    }
+
+    texture = new plug::Texture(atlas_width, shelf_y + shelf_height + 1);
+    ASSERT(texture, "Failed to allocate texture!\n");
+
+    for (size_t i = 0; i < textures.size(); i++) {
+        if (!textures[i]) {
+            regions.push_back(TextureRegion(*texture, 0, 0, 0, 0));
+            continue;
+        }
+
+        const plug::Texture &curr = *textures[i];
+        size_t x = positions[i].x, y = positions[i].y;
+
+        for (size_t row = 0; row < curr.height; row++) {
+            memcpy(
+                texture->data + (y + row) * texture->width + x,
+                curr.data + row * curr.width,
+                curr.width * sizeof(plug::Color)
+            );
+        }
+
+        regions.push_back(TextureRegion(*texture, x, y, curr.width, curr.height));
+    }
+
+    TEXTURE_CACHE.retain(*texture);
+}
+
+
+TextureAtlas::TextureAtlas(const TextureAtlas &atlas) :
+    texture(nullptr), regions()
+{
+    texture = new plug::Texture(*atlas.texture);
+    ASSERT(texture, "Failed to allocate texture!\n");
+
+    for (size_t i = 0; i < atlas.regions.size(); i++) {
+        const TextureRegion &region = atlas.regions[i];
+        regions.push_back(TextureRegion(*texture, region.x, region.y, region.width, region.height));
+    }
+
+    TEXTURE_CACHE.retain(*texture);
+}
+
+
+const TextureRegion &TextureAtlas::getRegion(size_t index) const {
+    ASSERT(index < regions.size(), "Index is out of range!\n");
+    return regions[index];
+}
+
+
+size_t TextureAtlas::getRegionCount() const { return regions.size(); }
+
+
+const plug::Texture &TextureAtlas::getTexture() const { return *texture; }
+
+
+TextureAtlas::~TextureAtlas() {
+    TEXTURE_CACHE.release(*texture);
+    delete texture;
+}
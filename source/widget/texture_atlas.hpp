@@ -0,0 +1,81 @@
+/**
+ * \file
+ * \brief Contains texture region and texture atlas interface
+*/
+
+
+#ifndef _TEXTURE_ATLAS_H_
+#define _TEXTURE_ATLAS_H_
+
+
+#include "common/list.hpp"
+#include "standart/Graphics.h"
+
+
+/// Rectangle inside texture that can be drawn as separate texture
+struct TextureRegion {
+    const plug::Texture *texture;   ///< Texture that contains region
+    size_t x;                       ///< Region left side in texture pixels
+    size_t y;                       ///< Region top side in texture pixels
+    size_t width;                   ///< Region width in pixels
+    size_t height;                  ///< Region height in pixels
+
+    /**
+     * \brief Creates region that covers the whole texture
+     * \note Implicit so plug::Texture can be used everywhere region is expected
+    */
+    TextureRegion(const plug::Texture &texture_);
+
+    /**
+     * \brief Creates region with specific position and size
+    */
+    TextureRegion(const plug::Texture &texture_, size_t x_, size_t y_, size_t width_, size_t height_);
+};
+
+
+/**
+ * \brief Several textures packed into one texture
+ * \note Texture is retained in texture cache, so all regions are drawn with the same GPU texture
+*/
+class TextureAtlas {
+public:
+    /**
+     * \brief Packs textures using shelf packing
+     * \note Textures are copied and can be deleted after construction
+    */
+    TextureAtlas(const List<plug::Texture*> &textures);
+
+    /**
+     * \brief Copies atlas texture and regions
+    */
+    TextureAtlas(const TextureAtlas &atlas);
+
+    TextureAtlas &operator = (const TextureAtlas &atlas) = delete;
+
+    /**
+     * \brief Returns region of the texture with the same index as in constructor
+    */
+    const TextureRegion &getRegion(size_t index) const;
+
+    /**
+     * \brief Returns amount of regions
+    */
+    size_t getRegionCount() const;
+
+    /**
+     * \brief Returns texture with all regions
+    */
+    const plug::Texture &getTexture() const;
+
+    /**
+     * \brief Frees atlas texture
+    */
+    ~TextureAtlas();
+
+private:
+    plug::Texture *texture;         ///< Texture with all packed textures
+    List<TextureRegion> regions;    ///< Packed textures positions
+};
+
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief Contains texture cache implementation
+*/
+
+
+#include "common/assert.hpp"
+#include "widget/render_fence.hpp"
+#include "widget/texture_cache.hpp"
+
+
+// ============================================================================
+
+
+TextureCache::TextureCache() :
+    entries(), stats() {}
+
+
+size_t TextureCache::getIndex(const plug::Texture &texture) const {
+    for (size_t i = 0; i < entries.size(); i++)
+        if (entries[i].texture == &texture) return i;
+
+    return entries.size();
+}
+
+
+void TextureCache::retain(const plug::Texture &texture) {
+    if (getIndex(texture) < entries.size()) return;
+
+    sf::Texture *gpu_texture = new sf::Texture();
+    ASSERT(gpu_texture, "Failed to allocate texture!\n");
+
+    // GENERATION IS AHEAD OF UPLOADED SO FIRST DRAW UPLOADS TEXTURE
+    entries.push_back({&texture, gpu_texture, 1, 0});
+}
+
+
+void TextureCache::markChanged(const plug::Texture &texture) {
+    size_t index = getIndex(texture);
+    if (index < entries.size()) entries[index].generation++;
+}
+
+
+void TextureCache::release(const plug::Texture &texture) {
+    size_t index = getIndex(texture);
+    if (index < entries.size()) {
+        // FRAME IN RENDER THREAD CAN STILL USE GPU COPY
+        RENDER_FENCE.wait();
+
+        delete entries[index].gpu_texture;
+        entries.remove(index);
+    }
+}
+
+
+bool TextureCache::isRetained(const plug::Texture &texture) const {
+    return getIndex(texture) < entries.size();
+}
+
+
+bool TextureCache::isResident(const plug::Texture &texture) const {
+    size_t index = getIndex(texture);
+    return index < entries.size() && entries[index].uploaded == entries[index].generation;
+}
+
+
+const sf::Texture &TextureCache::getTexture(const plug::Texture &texture, sf::Texture &scratch) {
+    size_t index = getIndex(texture);
+
+    if (index == entries.size()) {
+        upload(scratch, texture);
+        return scratch;
+    }
+
+    Entry &entry = entries[index];
+
+    if (entry.uploaded != entry.generation) {
+        // FRAME IN RENDER THREAD CAN STILL USE OLD CONTENT
+        RENDER_FENCE.wait();
+
+        upload(*entry.gpu_texture, texture);
+        entry.uploaded = entry.generation;
+    }
+    else
+        stats.hits++;
+
+    return *entry.gpu_texture;
+}
+
+
+void TextureCache::upload(sf::Texture &gpu_texture, const plug::Texture &texture) {
+    if (gpu_texture.getSize() != sf::Vector2u(texture.width, texture.height))
+        ASSERT(gpu_texture.create(texture.width, texture.height), "Failed to create SFML texture!\n");
+
+    gpu_texture.update(reinterpret_cast<const uint8_t*>(texture.data));
+
+    stats.misses++;
+    stats.uploaded_bytes += texture.width * texture.height * sizeof(plug::Color);
+}
+
+
+const TextureCacheStats &TextureCache::getStats() const { return stats; }
+
+
+void TextureCache::resetStats() { stats = TextureCacheStats(); }
+
+
+TextureCache &TextureCache::getInstance() {
+    static TextureCache texture_cache;
+    return texture_cache;
+}
+
+
+TextureCache::~TextureCache() {
+    for (size_t i = 0; i < entries.size(); i++)
+        delete entries[i].gpu_texture;
+}
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \brief Contains texture cache interface
+*/
+
+
+#ifndef _TEXTURE_CACHE_H_
+#define _TEXTURE_CACHE_H_
+
+
+#include "SFML/Graphics.hpp"
+#include "common/list.hpp"
+#include "standart/Graphics.h"
+
+
+/// Counters for checking how much data goes to GPU
+struct TextureCacheStats {
+    size_t hits;                ///< Draws that used resident texture
+    size_t misses;              ///< Draws that required texture upload
+    size_t uploaded_bytes;      ///< Amount of bytes uploaded to GPU
+
+    TextureCacheStats() : hits(0), misses(0), uploaded_bytes(0) {}
+};
+
+
+/**
+ * \brief Keeps GPU copies of plug::Texture resident between frames
+ * \note Only retained textures are cached, others are uploaded on every draw
+ * \note This class is a singleton (you must use getInstance to get it)
+*/
+class TextureCache {
+public:
+    /**
+     * \brief Makes texture resident until release() is called
+     * \note Owner must call markChanged() after every texture modification
+    */
+    void retain(const plug::Texture &texture);
+
+    /**
+     * \brief Increases texture generation so it will be uploaded on next draw
+    */
+    void markChanged(const plug::Texture &texture);
+
+    /**
+     * \brief Frees GPU copy of the texture
+     * \warning Call this method before deleting retained texture
+    */
+    void release(const plug::Texture &texture);
+
+    /**
+     * \brief Returns true if texture is retained
+    */
+    bool isRetained(const plug::Texture &texture) const;
+
+    /**
+     * \brief Returns true if texture is retained and its GPU copy is up to date
+    */
+    bool isResident(const plug::Texture &texture) const;
+
+    /**
+     * \brief Returns GPU copy of the texture uploading it if needed
+     * \note Not retained texture is uploaded to scratch, so every caller must pass its own scratch
+    */
+    const sf::Texture &getTexture(const plug::Texture &texture, sf::Texture &scratch);
+
+    /**
+     * \brief Returns counters since the last reset
+    */
+    const TextureCacheStats &getStats() const;
+
+    /**
+     * \brief Sets all counters to zero
+    */
+    void resetStats();
+
+    /**
+     * \brief Returns single instance of TextureCache
+    */
+    static TextureCache &getInstance();
+
+    /**
+     * \brief Frees all GPU textures
+    */
+    ~TextureCache();
+
+private:
+    /// Resident texture
+    struct Entry {
+        const plug::Texture *texture;   ///< Texture identity
+        sf::Texture *gpu_texture;       ///< GPU copy of the texture
+        size_t generation;              ///< Increased on every texture change
+        size_t uploaded;                ///< Generation that GPU copy has
+    };
+
+    TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+
+    TextureCache &operator = (const TextureCache&) = delete;
+
+    /**
+     * \brief Returns index of the texture entry
+    */
+    size_t getIndex(const plug::Texture &texture) const;
+
+    /**
+     * \brief Copies texture data to GPU texture
+    */
+    void upload(sf::Texture &gpu_texture, const plug::Texture &texture);
+
+    List<Entry> entries;            ///< Resident textures
+    TextureCacheStats stats;        ///< Cache counters
+};
+
+
+/// Shortcut for getting TextureCache instance
+#define TEXTURE_CACHE TextureCache::getInstance()
+
+
+#endif
@@ -0,0 +1,258 @@
+/**
+ * \file
+ * \brief Contains tiled texture implementation
+*/
+
+
+#include <algorithm>
+#include <cstring>
+#include "common/assert.hpp"
+#include "common/utils.hpp"
+#include "widget/tiled_texture.hpp"
+
+
+// ============================================================================
+
+
+TiledTexture::TiledTexture() :
+    width(0), height(0), columns(0), rows(0), tiles() {}
+
+
+TiledTexture::TiledTexture(size_t width_, size_t height_, const plug::Color &color) :
+    width(width_), height(height_),
+    columns((width_ + TEXTURE_TILE_SIZE - 1) / TEXTURE_TILE_SIZE),
+    rows((height_ + TEXTURE_TILE_SIZE - 1) / TEXTURE_TILE_SIZE),
+    tiles()
+{
+    if (columns * rows == 0) return;
+
+    // ALL TILES ARE THE SAME, SO THEY SHARE ONE TILE UNTIL SOMEBODY DRAWS ON THEM
+    Tile *tile = createTile(color);
+    tile->references = columns * rows;
+
+    tiles = List<Tile*>(columns * rows, tile);
+}
+
+
+TiledTexture::TiledTexture(const TiledTexture &texture) :
+    width(texture.width), height(texture.height),
+    columns(texture.columns), rows(texture.rows),
+    tiles(texture.tiles)
+{
+    for (size_t i = 0; i < tiles.size(); i++)
+        tiles[i]->references++;
+}
+
+
+TiledTexture &TiledTexture::operator = (const TiledTexture &texture) {
+    if (this == &texture) return *this;
+
+    // TILES ARE RETAINED FIRST, SO SHARED TILES ARE NOT DELETED IN BETWEEN
+    for (size_t i = 0; i < texture.tiles.size(); i++)
+        texture.tiles[i]->references++;
+
+    clearTiles();
+
+    width = texture.width;
+    height = texture.height;
+    columns = texture.columns;
+    rows = texture.rows;
+    tiles = texture.tiles;
+
+    return *this;
+}
+
+
+size_t TiledTexture::getWidth() const { return width; }
+
+
+size_t TiledTexture::getHeight() const { return height; }
+
+
+size_t TiledTexture::getColumns() const { return columns; }
+
+
+size_t TiledTexture::getRows() const { return rows; }
+
+
+size_t TiledTexture::getStamp(size_t column, size_t row) const {
+    ASSERT(column < columns && row < rows, "Tile is out of texture!\n");
+
+    return tiles[row * columns + column]->stamp;
+}
+
+
+plug::Color TiledTexture::getPixel(size_t x, size_t y) const {
+    return *getRow(x, y);
+}
+
+
+void TiledTexture::setPixel(size_t x, size_t y, const plug::Color &color) {
+    // SHARED TILE IS NOT COPIED IF NOTHING CHANGES
+    if (isEqual(*getRow(x, y), color)) return;
+
+    *editRow(x, y) = color;
+}
+
+
+const plug::Color *TiledTexture::getRow(size_t x, size_t y) const {
+    Tile *tile = getTile(x, y);
+
+    return tile->pixels + (y % TEXTURE_TILE_SIZE) * TEXTURE_TILE_SIZE + x % TEXTURE_TILE_SIZE;
+}
+
+
+plug::Color *TiledTexture::editRow(size_t x, size_t y) {
+    Tile *tile = editTile(x, y);
+
+    return tile->pixels + (y % TEXTURE_TILE_SIZE) * TEXTURE_TILE_SIZE + x % TEXTURE_TILE_SIZE;
+}
+
+
+void TiledTexture::fill(size_t x0, size_t y0, size_t x1, size_t y1, const plug::Color &color) {
+    x1 = std::min(x1, width);
+    y1 = std::min(y1, height);
+
+    if (x0 >= x1 || y0 >= y1) return;
+
+    Tile *solid = nullptr;
+
+    for (size_t row = y0 / TEXTURE_TILE_SIZE; row <= (y1 - 1) / TEXTURE_TILE_SIZE; row++) {
+        for (size_t column = x0 / TEXTURE_TILE_SIZE; column <= (x1 - 1) / TEXTURE_TILE_SIZE; column++) {
+            size_t tile_x0 = std::max(x0, column * TEXTURE_TILE_SIZE);
+            size_t tile_y0 = std::max(y0, row * TEXTURE_TILE_SIZE);
+            size_t tile_x1 = std::min(x1, (column + 1) * TEXTURE_TILE_SIZE);
+            size_t tile_y1 = std::min(y1, (row + 1) * TEXTURE_TILE_SIZE);
+
+            bool is_covered =
+                tile_x0 == column * TEXTURE_TILE_SIZE && tile_x1 == (column + 1) * TEXTURE_TILE_SIZE &&
+                tile_y0 == row * TEXTURE_TILE_SIZE && tile_y1 == (row + 1) * TEXTURE_TILE_SIZE;
+
+            if (is_covered) {
+                if (!solid) {
+                    solid = createTile(color);
+                    solid->references = 0;
+                }
+
+                solid->references++;
+
+                releaseTile(tiles[row * columns + column]);
+                tiles[row * columns + column] = solid;
+                continue;
+            }
+
+            for (size_t y = tile_y0; y < tile_y1; y++) {
+                plug::Color *line = editRow(tile_x0, y);
+
+                for (size_t x = 0; x < tile_x1 - tile_x0; x++)
+                    line[x] = color;
+            }
+        }
+    }
+}
+
+
+void TiledTexture::write(const plug::Color *src, size_t x, size_t y, size_t width_, size_t height_) {
+    ASSERT(x + width_ <= width && y + height_ <= height, "Region is out of texture!\n");
+
+    for (size_t line = 0; line < height_; line++) {
+        for (size_t column = x; column < x + width_;) {
+            size_t piece = std::min(TEXTURE_TILE_SIZE - column % TEXTURE_TILE_SIZE, x + width_ - column);
+            const plug::Color *piece_src = src + line * width_ + column - x;
+
+            // SHARED TILE IS NOT COPIED IF NOTHING CHANGES
+            if (memcmp(getRow(column, y + line), piece_src, piece * sizeof(plug::Color)))
+                memcpy(editRow(column, y + line), piece_src, piece * sizeof(plug::Color));
+
+            column += piece;
+        }
+    }
+}
+
+
+void TiledTexture::copyTo(plug::Color *dst, size_t x, size_t y, size_t width_, size_t height_) const {
+    ASSERT(x + width_ <= width && y + height_ <= height, "Region is out of texture!\n");
+
+    for (size_t line = 0; line < height_; line++) {
+        // EVERY TILE GIVES CONTINUOUS PIECE OF ROW
+        for (size_t column = x; column < x + width_;) {
+            size_t piece = std::min(TEXTURE_TILE_SIZE - column % TEXTURE_TILE_SIZE, x + width_ - column);
+
+            memcpy(dst + line * width_ + column - x, getRow(column, y + line), piece * sizeof(plug::Color));
+            column += piece;
+        }
+    }
+}
+
+
+TiledTexture::~TiledTexture() {
+    clearTiles();
+}
+
+
+TiledTexture::Tile::Tile() :
+    references(1), stamp(getNextStamp()), pixels() {}
+
+
+TiledTexture::Tile *TiledTexture::createTile(const plug::Color &color) {
+    Tile *tile = new Tile();
+    ASSERT(tile, "Failed to allocate tile!\n");
+
+    for (size_t i = 0; i < TEXTURE_TILE_SIZE * TEXTURE_TILE_SIZE; i++)
+        tile->pixels[i] = color;
+
+    return tile;
+}
+
+
+void TiledTexture::releaseTile(Tile *tile) {
+    ASSERT(tile->references, "Tile is already deleted!\n");
+
+    tile->references--;
+    if (!tile->references) delete tile;
+}
+
+
+size_t TiledTexture::getNextStamp() {
+    static size_t stamp = 0;
+    return ++stamp;
+}
+
+
+TiledTexture::Tile *TiledTexture::getTile(size_t x, size_t y) const {
+    ASSERT(x < width && y < height, "Pixel is out of texture!\n");
+
+    return tiles[(y / TEXTURE_TILE_SIZE) * columns + x / TEXTURE_TILE_SIZE];
+}
+
+
+TiledTexture::Tile *TiledTexture::editTile(size_t x, size_t y) {
+    ASSERT(x < width && y < height, "Pixel is out of texture!\n");
+
+    Tile *&tile = tiles[(y / TEXTURE_TILE_SIZE) * columns + x / TEXTURE_TILE_SIZE];
+
+    if (tile->references > 1) {
+        Tile *copy = new Tile();
+        ASSERT(copy, "Failed to allocate tile!\n");
+
+        memcpy(copy->pixels, tile->pixels, sizeof(tile->pixels));
+
+        releaseTile(tile);
+        tile = copy;
+    }
+
+    // CONTENT IS ABOUT TO CHANGE, SO CACHED COPIES OF THIS TILE BECOME OUTDATED
+    tile->stamp = getNextStamp();
+
+    return tile;
+}
+
+
+void TiledTexture::clearTiles() {
+    for (size_t i = 0; i < tiles.size(); i++)
+        releaseTile(tiles[i]);
+
+    tiles = List<Tile*>();
+
+    width = height = columns = rows = 0;
+}
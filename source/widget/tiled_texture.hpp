@@ -0,0 +1,167 @@
+/**
+ * \file
+ * \brief Contains tiled texture interface
+*/
+
+
+#ifndef _TILED_TEXTURE_H_
+#define _TILED_TEXTURE_H_
+
+
+#include <cstddef>
+#include "common/list.hpp"
+#include "standart/Graphics.h"
+
+
+const size_t TEXTURE_TILE_SIZE = 128;   ///< Side of square texture tile in pixels
+
+
+/**
+ * \brief Image split into square tiles that are shared between copies until one of them changes them
+ * \note Copying texture copies only tile pointers, so snapshots cost memory proportional to edited area
+ * \note Tiles filled with one color are shared too, so blank images take one tile
+*/
+class TiledTexture {
+public:
+    /**
+     * \brief Creates empty texture
+    */
+    TiledTexture();
+
+    /**
+     * \brief Creates texture filled with color
+    */
+    TiledTexture(size_t width_, size_t height_, const plug::Color &color);
+
+    /**
+     * \brief Shares all tiles with other texture
+    */
+    TiledTexture(const TiledTexture &texture);
+
+    /**
+     * \brief Releases own tiles and shares all tiles with other texture
+    */
+    TiledTexture &operator = (const TiledTexture &texture);
+
+    /**
+     * \brief Returns width in pixels
+    */
+    size_t getWidth() const;
+
+    /**
+     * \brief Returns height in pixels
+    */
+    size_t getHeight() const;
+
+    /**
+     * \brief Returns amount of tile columns
+    */
+    size_t getColumns() const;
+
+    /**
+     * \brief Returns amount of tile rows
+    */
+    size_t getRows() const;
+
+    /**
+     * \brief Returns number that changes every time tile content changes
+     * \note Stamps are unique among all tiles, so equal stamps mean equal content
+    */
+    size_t getStamp(size_t column, size_t row) const;
+
+    /**
+     * \brief Returns pixel color
+    */
+    plug::Color getPixel(size_t x, size_t y) const;
+
+    /**
+     * \brief Sets pixel color
+     * \note Shared tile is copied only if color really changes
+    */
+    void setPixel(size_t x, size_t y, const plug::Color &color);
+
+    /**
+     * \brief Returns pixel for reading, the next pixels up to the tile border follow it
+    */
+    const plug::Color *getRow(size_t x, size_t y) const;
+
+    /**
+     * \brief Returns pixel for writing, the next pixels up to the tile border follow it
+     * \note Copies tile if it is shared and changes its stamp
+    */
+    plug::Color *editRow(size_t x, size_t y);
+
+    /**
+     * \brief Fills region [x0, x1) x [y0, y1) with color
+     * \note Completely covered tiles are replaced by one shared tile
+    */
+    void fill(size_t x0, size_t y0, size_t x1, size_t y1, const plug::Color &color);
+
+    /**
+     * \brief Copies continuous array with width pixels in row to region
+     * \note Tiles are copied only where pixels really change
+    */
+    void write(const plug::Color *src, size_t x, size_t y, size_t width, size_t height);
+
+    /**
+     * \brief Copies region to continuous array with width pixels in row
+    */
+    void copyTo(plug::Color *dst, size_t x, size_t y, size_t width, size_t height) const;
+
+    /**
+     * \brief Releases all tiles
+    */
+    ~TiledTexture();
+
+private:
+    /// Square part of texture that can be shared
+    struct Tile {
+        /**
+         * \brief Creates tile used by one texture with new stamp
+        */
+        Tile();
+
+        size_t references;                                              ///< Amount of textures using tile
+        size_t stamp;                                                   ///< Unique content version
+        plug::Color pixels[TEXTURE_TILE_SIZE * TEXTURE_TILE_SIZE];      ///< Tile pixels by rows
+    };
+
+    /**
+     * \brief Allocates tile filled with color
+    */
+    static Tile *createTile(const plug::Color &color);
+
+    /**
+     * \brief Forgets tile deleting it if nobody else uses it
+    */
+    static void releaseTile(Tile *tile);
+
+    /**
+     * \brief Returns new unique stamp
+    */
+    static size_t getNextStamp();
+
+    /**
+     * \brief Returns tile containing pixel
+    */
+    Tile *getTile(size_t x, size_t y) const;
+
+    /**
+     * \brief Makes tile containing pixel owned only by this texture and changes its stamp
+    */
+    Tile *editTile(size_t x, size_t y);
+
+    /**
+     * \brief Releases all tiles and makes texture empty
+    */
+    void clearTiles();
+
+    size_t width;                   ///< Width in pixels
+    size_t height;                  ///< Height in pixels
+    size_t columns;                 ///< Amount of tile columns
+    size_t rows;                    ///< Amount of tile rows
+    List<Tile*> tiles;              ///< Tiles by rows
+};
+
+
+#endif
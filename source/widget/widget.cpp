@@ -6,6 +6,8 @@
 
 #include <cmath>
 #include "widget.hpp"
+#include "widget/damage_tracker.hpp"
+#include "widget/overlay.hpp"
 
 
 // ============================================================================
@@ -15,7 +17,10 @@ Widget::Widget(size_t id_, const plug::LayoutBox &layout_) :
     id(generateId(id_)),
     layout(layout_.clone()),
     parent(nullptr),
-    status(Status::Normal)
+    status(Status::Normal),
+    display_list(nullptr),
+    is_display_list_valid(false),
+    display_list_layout()
 {}
 
 
@@ -23,13 +28,20 @@ Widget::Widget(const Widget &widget) :
     id(AUTO_ID),
     layout(widget.getLayoutBox().clone()),
     parent(nullptr),
-    status(Status::Normal)
-{}
+    status(Status::Normal),
+    display_list(nullptr),
+    is_display_list_valid(false),
+    display_list_layout()
+{
+    setRetained(widget.isRetained());
+}
 
 
 Widget &Widget::operator = (const Widget &widget) {
-    if (this != &widget)
+    if (this != &widget) {
         layout = widget.getLayoutBox().clone();
+        is_display_list_valid = false;
+    }
     return *this;
 }
 
@@ -49,12 +61,59 @@ plug::LayoutBox &Widget::getLayoutBox() { return *layout; }
 const plug::LayoutBox &Widget::getLayoutBox() const { return *layout; }
 
 
-void Widget::setLayoutBox(const plug::LayoutBox &layout_) { layout = layout_.clone(); }
+void Widget::setLayoutBox(const plug::LayoutBox &layout_) {
+    invalidate();
+    layout = layout_.clone();
+    invalidate();
+}
 
 
 plug::Transform Widget::getTransform() const { return plug::Transform(layout->getPosition()); }
 
 
+plug::Transform Widget::getGlobalTransform() const {
+    plug::Transform transform = getTransform();
+
+    // EVERY PARENT APPLIES ITS TRANSFORM BEFORE DRAWING CHILDREN
+    for (const Widget *ancestor = parent; ancestor; ancestor = ancestor->getParent())
+        transform = transform.combine(ancestor->getTransform());
+
+    return transform;
+}
+
+
+Rect Widget::getGlobalRect() const {
+    plug::Transform transform = getGlobalTransform();
+
+    return Rect(transform.getOffset(), layout->getSize() * transform.getScale());
+}
+
+
+bool Widget::isOccluded(const Rect &rect) const {
+    const Widget *child = this;
+
+    // EVERY ANCESTOR CAN DRAW SOMETHING AFTER THE BRANCH THAT CONTAINS THIS WIDGET
+    for (const Widget *ancestor = parent; ancestor; ancestor = ancestor->getParent()) {
+        if (ancestor->drawsOver(*child, rect)) return true;
+        child = ancestor;
+    }
+
+    return false;
+}
+
+
+void Widget::invalidate() {
+    is_display_list_valid = false;
+
+    for (Widget *ancestor = parent; ancestor; ancestor = ancestor->getParent()) {
+        ancestor->is_display_list_valid = false;
+        ancestor->onChildInvalidate();
+    }
+
+    DAMAGE_TRACKER.addDamage(getGlobalRect());
+}
+
+
 Widget *Widget::getParent() { return parent; }
 
 
@@ -66,6 +125,8 @@ void Widget::setParent(Widget *parent_) {
 
     if (parent)
         layout->onParentUpdate(parent->getLayoutBox());
+
+    invalidate();
 }
 
 
@@ -77,7 +138,12 @@ Widget *Widget::findWidget(size_t widget_id) {
 Widget::Status Widget::getStatus() const { return status; }
 
 
-void Widget::setStatus(Status new_status) { status = new_status; }
+void Widget::setStatus(Status new_status) {
+    if (status == new_status) return;
+
+    status = new_status;
+    invalidate();
+}
 
 
 void Widget::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
@@ -133,8 +199,55 @@ bool Widget::covers(plug::TransformStack &stack, const plug::Vec2d &position) co
 }
 
 
+void Widget::render(plug::TransformStack &stack, plug::RenderTarget &result) {
+    // PLUGIN TARGETS CAN NOT REPLAY DRAWS WITH SFML TEXTURES, SO THEY ARE DRAWN DIRECTLY
+    if (!display_list || !dynamic_cast<SFMLTextureTarget*>(&result)) {
+        draw(stack, result);
+        return;
+    }
+
+    Rect layout_rect(layout->getPosition(), layout->getSize());
+
+    if (!is_display_list_valid || !isEqual(layout_rect, display_list_layout)) {
+        // WIDGET CAN INVALIDATE ITSELF WHILE DRAWING SO LIST IS VALIDATED BEFORE
+        is_display_list_valid = true;
+        display_list_layout = layout_rect;
+
+        // LIST IS RECORDED IN PARENT COORDINATES, SO PARENT CAN MOVE WITHOUT RECORDING AGAIN
+        TransformStack local_stack;
+
+        display_list->reset();
+        draw(local_stack, *display_list);
+    }
+
+    display_list->replay(stack, result);
+}
+
+
+void Widget::setRetained(bool is_retained) {
+    if (is_retained == isRetained()) return;
+
+    if (is_retained) {
+        display_list = new DisplayList();
+        ASSERT(display_list, "Failed to allocate display list!\n");
+    }
+    else {
+        delete display_list;
+        display_list = nullptr;
+    }
+
+    is_display_list_valid = false;
+}
+
+
+bool Widget::isRetained() const { return display_list != nullptr; }
+
+
 Widget::~Widget() {
+    OVERLAY.release(*this);
+
     delete layout;
+    if (display_list) delete display_list;
 }
 
 
@@ -12,6 +12,8 @@
 #include "SFML/Graphics.hpp"
 #include "config/configs.hpp"
 #include "common/list.hpp"
+#include "common/rect.hpp"
+#include "widget/display_list.hpp"
 #include "widget/layout_box.hpp"
 #include "widget/transform.hpp"
 #include "render_target.hpp"
@@ -78,6 +80,40 @@ public:
     */
     plug::Transform getTransform() const;
 
+    /**
+     * \brief Returns transform from widget coordinates to screen coordinates
+    */
+    plug::Transform getGlobalTransform() const;
+
+    /**
+     * \brief Returns region that widget occupies on screen
+     * \note Widgets that draw outside of their layout box must extend it
+    */
+    virtual Rect getGlobalRect() const;
+
+    /**
+     * \brief Returns true if something drawn after this widget overlaps rectangle
+    */
+    bool isOccluded(const Rect &rect) const;
+
+    /**
+     * \brief Returns true if something this widget draws after its child overlaps rectangle
+     * \note By default widget has no children
+    */
+    virtual bool drawsOver(const Widget &child, const Rect &rect) const { return false; }
+
+    /**
+     * \brief Returns true if widget covers its global rect with opaque pixels
+     * \note Widgets behind opaque widgets are not drawn
+    */
+    virtual bool isOpaque() const { return false; }
+
+    /**
+     * \brief Marks widget region as damaged so it will be redrawn on the next frame
+     * \note Notifies all parents about the change
+    */
+    void invalidate();
+
     /**
      * \brief Returns parent
     */
@@ -105,6 +141,7 @@ public:
 
     /**
      * \brief Sets widget status
+     * \note Damages widget region if status has changed
     */
     void setStatus(Status new_status);
 
@@ -114,6 +151,29 @@ public:
     */
     virtual void draw(plug::TransformStack &stack, plug::RenderTarget &result) override;
 
+    /**
+     * \brief Draws content that changes often over the cached scene
+     * \note Called only for overlay owner, stack is the same as in draw() but in screen coordinates
+    */
+    virtual void drawOverlay(plug::TransformStack &stack, plug::RenderTarget &result) {}
+
+    /**
+     * \brief Draws widget replaying its display list if widget is retained
+     * \note Parents should draw children using this method
+    */
+    void render(plug::TransformStack &stack, plug::RenderTarget &result);
+
+    /**
+     * \brief Makes widget record its draws once and replay them until it is invalidated
+     * \note Only for widgets whose image depends on nothing but their state and layout
+    */
+    void setRetained(bool is_retained);
+
+    /**
+     * \brief Returns true if widget replays recorded draws
+    */
+    bool isRetained() const;
+
     /**
      * \brief Handle all sorts of events event
     */
@@ -131,7 +191,14 @@ public:
     virtual void checkChildren() {}
 
     /**
-     * \brief Delete layout box
+     * \brief Called when some widget inside this one was invalidated
+     * \note By default does nothing
+    */
+    virtual void onChildInvalidate() {}
+
+    /**
+     * \brief Delete layout box and display list
+     * \note Releases overlay if widget owns it
     */
     virtual ~Widget() override;
 
@@ -147,6 +214,9 @@ protected:
     plug::LayoutBox *layout;      ///< Widget position and size encapsulated
     Widget *parent;         ///< Parent that holds this widget
     Status status;          ///< Shows parent if some actions requiered
+    DisplayList *display_list;      ///< Recorded draws, nullptr if widget is not retained
+    bool is_display_list_valid;     ///< False if widget has changed since recording
+    Rect display_list_layout;       ///< Layout position and size that display list was recorded with
 };
 
 
@@ -45,6 +45,15 @@ void Dialog::onEvent(const plug::Event &event, plug::EHC &ehc) {
 }
 
 
+void Dialog::addButton(RectButton *button) {
+    ASSERT(button, "Button is nullptr!\n");
+
+    // DIALOG BUTTONS CHANGE ONLY ON HOVER AND PRESS
+    button->setRetained(true);
+    container.addChild(button);
+}
+
+
 // ============================================================================
 
 
@@ -63,7 +72,7 @@ ConfirmDialog::ConfirmDialog(
     ok_action_->setDialog(*this);
     cancel_action_->setDialog(*this);
 
-    container.addChild(new RectButton(
+    addButton(new RectButton(
         1,
         LazyLayoutBox(plug::Vec2d(), plug::Vec2d(100, 50)),
         ok_action_,
@@ -71,7 +80,7 @@ ConfirmDialog::ConfirmDialog(
         button_style_
     ));
 
-    container.addChild(new RectButton(
+    addButton(new RectButton(
         2,
         LazyLayoutBox(plug::Vec2d(120, 0), plug::Vec2d(100, 50)),
         cancel_action_,
@@ -119,7 +128,7 @@ SelectFileDialog::SelectFileDialog(
         LINE_EDIT_BORDER_THICKNESS
     );
 
-    container.addChild(new RectButton(
+    addButton(new RectButton(
         1,
         LazyLayoutBox(plug::Vec2d(0, 50), plug::Vec2d(100, 50)),
         select_action_,
@@ -127,7 +136,7 @@ SelectFileDialog::SelectFileDialog(
         button_style
     ));
 
-    container.addChild(new RectButton(
+    addButton(new RectButton(
         2,
         LazyLayoutBox(plug::Vec2d(120, 50), plug::Vec2d(100, 50)),
         cancel_action_,
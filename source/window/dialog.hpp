@@ -29,6 +29,11 @@ protected:
         size_t id_, const plug::LayoutBox &layout_,
         const std::string &title_, const WindowStyle &style_
     );
+
+    /**
+     * \brief Adds retained button to dialog content
+    */
+    void addButton(RectButton *button);
 };
 
 
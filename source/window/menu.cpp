@@ -59,7 +59,13 @@ void MenuButton::addButton(const std::string &text_, ButtonAction *action_) {
 
 
 void MenuButton::setOpened(bool is_opened_) {
+    if (is_opened == is_opened_) return;
+
     is_opened = is_opened_;
+
+    // OPTIONS ARE DRAWN OUTSIDE OF THE MENU BUTTON
+    for (size_t i = 0; i < buttons.size(); i++)
+        buttons[i]->invalidate();
 }
 
 
@@ -113,6 +119,9 @@ Menu::Menu(
     plug::Vec2d auto_size(layout->getSize().x, btn_text.getLocalBounds().height + ADD_SIZE.y);
 
     layout->setSize(auto_size);
+
+    // MENU CHANGES ONLY WHEN ITS BUTTONS DO
+    setRetained(true);
 }
 
 
@@ -59,11 +59,6 @@ protected:
     plug::Color background;           ///< Menu background color
     size_t opened;                  ///< Index of opened menu button
 
-    /**
-     * \brief True if some menu button is opened
-    */
-    bool isMenuOpened() const;
-
     /**
      * \brief Sets menu button as opened
     */
@@ -75,6 +70,11 @@ public:
         const RectButtonStyle &style_, plug::Color background_
     );
 
+    /**
+     * \brief True if some menu button is opened
+    */
+    bool isMenuOpened() const;
+
     /**
      * \brief Adds menu button
     */
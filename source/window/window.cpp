@@ -218,7 +218,12 @@ Window::Window(
     ),
     container(CONTAINER_ID, ContainerLayoutBox(*this)),
     menu(nullptr),
-    title(sf::Text(title_, style.font, style.font_size))
+    title(sf::Text(title_, style.font, style.font_size)),
+    layer(nullptr),
+    is_layer_valid(false),
+    frame(plug::Triangles, 0),
+    frame_buffer(sf::Triangles, sf::VertexBuffer::Static),
+    frame_size()
 {
     title.setColor(style.title_color);
 
@@ -313,28 +318,32 @@ plug::Vec2d Window::getAreaSize() const {
 }
 
 
-#define DRAW_TEXTURE(TEXTURE_ID, POSITION, TEXTURE_RECT_SIZE) \
-    TextureShape(style.asset[TEXTURE_ID]).draw(result, POSITION + global_position, applySize(stack, TEXTURE_RECT_SIZE))
+void Window::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
+    if (layer) {
+        updateLayer();
 
+        drawRenderTexture(
+            result, *layer,
+            stack.apply(layout->getPosition()), applySize(stack, layout->getSize())
+        );
+    }
+    else
+        drawContent(stack, result);
 
-void Window::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
-    plug::Vec2d global_position = stack.apply(layout->getPosition());
+    // MENU OPTIONS ARE DRAWN OUTSIDE OF THE WINDOW SO MENU IS NOT PART OF THE LAYER
+    TransformApplier add_transform(stack, getTransform());
 
-    plug::Vec2d tl_size = plug::Vec2d(style.asset[WindowAsset::FRAME_TL].width, style.asset[WindowAsset::FRAME_TL].height);
-    plug::Vec2d br_size = plug::Vec2d(style.asset[WindowAsset::FRAME_BL].width, style.asset[WindowAsset::FRAME_BL].height);
+    if (menu) menu->render(stack, result);
+}
 
-    double center_h = layout->getSize().y - tl_size.y - br_size.y;
-    double center_w = layout->getSize().x - tl_size.x - br_size.x;
 
-    DRAW_TEXTURE(WindowAsset::FRAME_TL,     plug::Vec2d(),                                            tl_size);
-    DRAW_TEXTURE(WindowAsset::FRAME_L,      plug::Vec2d(0, tl_size.y),                                plug::Vec2d(tl_size.x, center_h));
-    DRAW_TEXTURE(WindowAsset::FRAME_BL,     plug::Vec2d(0, tl_size.y + center_h),                     plug::Vec2d(tl_size.x, br_size.y));
-    DRAW_TEXTURE(WindowAsset::FRAME_B,      plug::Vec2d(tl_size.x, tl_size.y + center_h),             plug::Vec2d(center_w, br_size.y));
-    DRAW_TEXTURE(WindowAsset::FRAME_BR,     plug::Vec2d(tl_size.x + center_w, tl_size.y + center_h),  br_size);
-    DRAW_TEXTURE(WindowAsset::FRAME_R,      plug::Vec2d(tl_size.x + center_w, tl_size.y),             plug::Vec2d(br_size.x, center_h));
-    DRAW_TEXTURE(WindowAsset::FRAME_TR,     plug::Vec2d(tl_size.x + center_w, 0),                     plug::Vec2d(br_size.x, tl_size.y));
-    DRAW_TEXTURE(WindowAsset::TITLE,        plug::Vec2d(tl_size.x, 0),                                plug::Vec2d(center_w, tl_size.y));
-    DRAW_TEXTURE(WindowAsset::FRAME_CENTER, tl_size,                                            plug::Vec2d(center_w, center_h));
+void Window::drawContent(plug::TransformStack &stack, plug::RenderTarget &result) {
+    plug::Vec2d global_position = stack.apply(layout->getPosition());
+
+    // CHILDREN AND TITLE MUST NOT BE DRAWN OUTSIDE OF THE FRAME
+    ClipApplier clip(result, Rect(global_position, applySize(stack, layout->getSize())));
+
+    drawFrame(stack, result);
 
     title.draw(result, global_position + style.title_offset - title.getTextOffset(), applySize(stack, title.getTextureSize()));
 
@@ -342,12 +351,158 @@ void Window::draw(plug::TransformStack &stack, plug::RenderTarget &result) {
 
     container.draw(stack, result);
     buttons.draw(stack, result);
+}
+
+
+void Window::drawFrame(plug::TransformStack &stack, plug::RenderTarget &result) {
+    updateFrame();
+
+    plug::Vec2d global_position = stack.apply(layout->getPosition());
+    plug::Vec2d scale = applySize(stack, plug::Vec2d(1, 1));
+
+    // ALL FRAME TEXTURES ARE REGIONS OF THE SAME ASSET ATLAS
+    const plug::Texture &texture = *style.asset[WindowAsset::FRAME_CENTER].texture;
+
+    RenderTarget *target = dynamic_cast<RenderTarget*>(&result);
+
+    if (target && sf::VertexBuffer::isAvailable()) {
+        target->draw(frame_buffer, texture, global_position, scale);
+        return;
+    }
+
+    static plug::VertexArray array(plug::Triangles, 0);
+    array.resize(frame.getSize());
 
-    if (menu) menu->draw(stack, result);
+    for (size_t i = 0; i < frame.getSize(); i++) {
+        array[i] = frame[i];
+        array[i].position = global_position + frame[i].position * scale;
+    }
+
+    result.draw(array, texture);
 }
 
 
-#undef DRAW_TEXTURE
+void Window::updateFrame() {
+    if (frame.getSize() && isEqual(frame_size, layout->getSize())) return;
+
+    frame_size = layout->getSize();
+    frame.resize(0);
+
+    plug::Vec2d tl_size = plug::Vec2d(style.asset[WindowAsset::FRAME_TL].width, style.asset[WindowAsset::FRAME_TL].height);
+    plug::Vec2d br_size = plug::Vec2d(style.asset[WindowAsset::FRAME_BL].width, style.asset[WindowAsset::FRAME_BL].height);
+
+    double center_h = frame_size.y - tl_size.y - br_size.y;
+    double center_w = frame_size.x - tl_size.x - br_size.x;
+
+    appendFrameRect(WindowAsset::FRAME_TL,     plug::Vec2d(),                                            tl_size);
+    appendFrameRect(WindowAsset::FRAME_L,      plug::Vec2d(0, tl_size.y),                                plug::Vec2d(tl_size.x, center_h));
+    appendFrameRect(WindowAsset::FRAME_BL,     plug::Vec2d(0, tl_size.y + center_h),                     plug::Vec2d(tl_size.x, br_size.y));
+    appendFrameRect(WindowAsset::FRAME_B,      plug::Vec2d(tl_size.x, tl_size.y + center_h),             plug::Vec2d(center_w, br_size.y));
+    appendFrameRect(WindowAsset::FRAME_BR,     plug::Vec2d(tl_size.x + center_w, tl_size.y + center_h),  br_size);
+    appendFrameRect(WindowAsset::FRAME_R,      plug::Vec2d(tl_size.x + center_w, tl_size.y),             plug::Vec2d(br_size.x, center_h));
+    appendFrameRect(WindowAsset::FRAME_TR,     plug::Vec2d(tl_size.x + center_w, 0),                     plug::Vec2d(br_size.x, tl_size.y));
+    appendFrameRect(WindowAsset::TITLE,        plug::Vec2d(tl_size.x, 0),                                plug::Vec2d(center_w, tl_size.y));
+    appendFrameRect(WindowAsset::FRAME_CENTER, tl_size,                                                  plug::Vec2d(center_w, center_h));
+
+    if (!sf::VertexBuffer::isAvailable()) return;
+
+    // BUFFER IS UPLOADED ONLY ON RESIZE, MOVING WINDOW CHANGES DRAW TRANSFORM ONLY
+    sf::VertexArray vertices(sf::Triangles, frame.getSize());
+
+    for (size_t i = 0; i < frame.getSize(); i++)
+        vertices[i] = sf::Vertex(
+            getSfmlVector2f(frame[i].position),
+            getSfmlColor(frame[i].color),
+            getSfmlVector2f(frame[i].tex_coords)
+        );
+
+    if (frame_buffer.getVertexCount() != frame.getSize())
+        ASSERT(frame_buffer.create(frame.getSize()), "Failed to create vertex buffer!\n");
+
+    ASSERT(frame_buffer.update(&vertices[0]), "Failed to update vertex buffer!\n");
+}
+
+
+void Window::appendFrameRect(WindowAsset::TEXTURE_ID texture_id, const plug::Vec2d &position, const plug::Vec2d &size) {
+    const TextureRegion &region = style.asset[texture_id];
+
+    ASSERT(region.texture == style.asset[WindowAsset::FRAME_CENTER].texture, "Frame textures must share atlas!\n");
+
+    plug::Vec2d tex_start(region.x, region.y);
+    plug::Vec2d tex_end(region.x + region.width, region.y + region.height);
+
+    plug::Vertex top_left(position, plug::Color(), tex_start);
+    plug::Vertex bottom_left(plug::Vec2d(position.x, position.y + size.y), plug::Color(), plug::Vec2d(tex_start.x, tex_end.y));
+    plug::Vertex bottom_right(position + size, plug::Color(), tex_end);
+    plug::Vertex top_right(plug::Vec2d(position.x + size.x, position.y), plug::Color(), plug::Vec2d(tex_end.x, tex_start.y));
+
+    frame.appendVertex(top_left);
+    frame.appendVertex(bottom_left);
+    frame.appendVertex(bottom_right);
+
+    frame.appendVertex(top_left);
+    frame.appendVertex(bottom_right);
+    frame.appendVertex(top_right);
+}
+
+
+void Window::updateLayer() {
+    plug::Vec2d size = alignToPixels(Rect(plug::Vec2d(), layout->getSize())).size;
+
+    if (!isEqual(layer->getSize(), size)) {
+        layer->create(size.x, size.y);
+        is_layer_valid = false;
+    }
+
+    if (is_layer_valid) return;
+
+    // CHILDREN CAN INVALIDATE LAYER WHILE DRAWING SO IT IS VALIDATED BEFORE
+    is_layer_valid = true;
+
+    layer->clear(plug::Color(0, 0, 0, 0));
+
+    // WINDOW IS DRAWN AT TOP LEFT CORNER OF THE LAYER
+    TransformStack layer_stack;
+    TransformApplier layer_transform(layer_stack, plug::Transform(layout->getPosition() * -1));
+
+    drawContent(layer_stack, *layer);
+
+    layer->flush();
+}
+
+
+void Window::setLayered(bool is_layered) {
+    if (is_layered == isLayered()) return;
+
+    if (is_layered) {
+        layer = new RenderTexture();
+        ASSERT(layer, "Failed to allocate layer!\n");
+    }
+    else {
+        delete layer;
+        layer = nullptr;
+    }
+
+    is_layer_valid = false;
+    invalidate();
+}
+
+
+bool Window::isLayered() const { return layer != nullptr; }
+
+
+void Window::onChildInvalidate() { is_layer_valid = false; }
+
+
+bool Window::drawsOver(const Widget &child, const Rect &rect) const {
+    // WINDOW DRAWS CONTAINER, THEN BUTTONS, THEN MENU
+    if (&child == &container && buttons.hasChildOver(rect)) return true;
+
+    if (!menu || &child == menu) return false;
+
+    // OPENED OPTIONS ARE OUTSIDE OF THE MENU RECT AND CAN COVER ANYTHING
+    return menu->isMenuOpened() || !intersect(menu->getGlobalRect(), rect).isEmpty();
+}
 
 
 void Window::setMenu(Menu *menu_) {
@@ -431,13 +586,22 @@ void Window::onMousePressed(const plug::MousePressedEvent &event, plug::EHC &ehc
 
 
 bool Window::setPosition(const plug::Vec2d &position_) {
-    return layout->setPosition(position_);
+    invalidate();
+
+    if (!layout->setPosition(position_)) return false;
+
+    invalidate();
+    return true;
 }
 
 
 bool Window::setSize(const plug::Vec2d &size_) {
+    invalidate();
+
     if (!layout->setSize(size_)) return false;
 
+    invalidate();
+
     buttons.onParentUpdate(*layout);
     container.onParentUpdate(*layout);
     
@@ -466,6 +630,7 @@ void Window::checkChildren() {
 
 Window::~Window() {
     if (menu) delete menu;
+    if (layer) delete layer;
 }
 
 
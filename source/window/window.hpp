@@ -121,6 +121,17 @@ public:
     */
     const WindowStyle &getStyle() const { return style; }
 
+    /**
+     * \brief Enables drawing window into its own texture that is redrawn only after changes inside
+     * \note Moving layered window only composites its texture at new position
+    */
+    void setLayered(bool is_layered);
+
+    /**
+     * \brief Returns true if window draws into its own texture
+    */
+    bool isLayered() const;
+
     /**
      * \brief Draws window frame, title bar and its content
     */
@@ -142,7 +153,22 @@ public:
     virtual void checkChildren() override;
 
     /**
-     * \brief Delete menu if window has one
+     * \brief Marks layer as outdated
+    */
+    virtual void onChildInvalidate() override;
+
+    /**
+     * \brief Returns true if buttons or menu drawn after child overlap rectangle
+    */
+    virtual bool drawsOver(const Widget &child, const Rect &rect) const override;
+
+    /**
+     * \brief Returns true because frame textures cover the whole window
+    */
+    virtual bool isOpaque() const override { return true; }
+
+    /**
+     * \brief Delete menu and layer if window has them
     */
     virtual ~Window() override;
 
@@ -150,11 +176,41 @@ protected:
     virtual void onMouseMove(const plug::MouseMoveEvent &event, plug::EHC &ehc) override;
     virtual void onMousePressed(const plug::MousePressedEvent &event, plug::EHC &ehc) override;
 
+    /**
+     * \brief Draws window frame, title bar, buttons and content without menu
+    */
+    void drawContent(plug::TransformStack &stack, plug::RenderTarget &result);
+
+    /**
+     * \brief Redraws layer if it is outdated
+    */
+    void updateLayer();
+
+    /**
+     * \brief Draws frame, title bar and center with one draw call
+    */
+    void drawFrame(plug::TransformStack &stack, plug::RenderTarget &result);
+
+    /**
+     * \brief Rebuilds frame mesh if window was resized
+    */
+    void updateFrame();
+
+    /**
+     * \brief Appends two triangles that stretch asset texture over rectangle
+    */
+    void appendFrameRect(WindowAsset::TEXTURE_ID texture_id, const plug::Vec2d &position, const plug::Vec2d &size);
+
     WindowStyle style;          ///< Window style
     Container buttons;          ///< Window title bar and resize buttons
     Container container;        ///< Window content manager
     Menu *menu;                 ///< Window menu
     TextShape title;            ///< Window title
+    RenderTexture *layer;       ///< Cached window image, nullptr if window is not layered
+    bool is_layer_valid;        ///< False if something inside window has changed since last layer update
+    plug::VertexArray frame;    ///< Nine-slice frame mesh relative to window position
+    sf::VertexBuffer frame_buffer;  ///< GPU copy of frame mesh
+    plug::Vec2d frame_size;     ///< Window size that frame mesh was built for
 
 private:
     /**
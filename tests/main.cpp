@@ -0,0 +1,48 @@
+/**
+ * \file
+ * \brief Runs all headless tests
+*/
+
+
+#include <cstdio>
+#include "test.hpp"
+
+
+static size_t checks = 0;       ///< Amount of performed checks
+static size_t failed = 0;       ///< Amount of failed checks
+
+
+// ============================================================================
+
+
+int main() {
+    testPixelConvert();
+    testSelectionMask();
+    testTiledTexture();
+    testSoftwareTarget();
+
+    printf("%lu of %lu checks failed\n", failed, checks);
+
+    return (failed) ? 1 : 0;
+}
+
+
+bool checkCondition(bool condition, const char *text, const char *file, int line) {
+    checks++;
+
+    if (!condition) {
+        failed++;
+        printf("%s:%d: check failed: %s\n", file, line, text);
+    }
+
+    return condition;
+}
+
+
+unsigned getRandom() {
+    // LINEAR CONGRUENTIAL GENERATOR, SO EVERY RUN CHECKS THE SAME DATA
+    static unsigned state = 12345;
+
+    state = state * 1103515245 + 12345;
+    return state >> 16;
+}
@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief Contains headless test helpers and test suites
+*/
+
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+
+#include <cstddef>
+
+
+/// Checks condition and reports its text and location if it is false
+#define CHECK(condition) checkCondition((condition), #condition, __FILE__, __LINE__)
+
+
+/**
+ * \brief Counts check and prints it if condition is false
+ * \return Condition value
+*/
+bool checkCondition(bool condition, const char *text, const char *file, int line);
+
+
+/**
+ * \brief Returns pseudo random number that is the same on every run
+*/
+unsigned getRandom();
+
+
+/**
+ * \brief Compares vector pixel conversion kernels with scalar code
+*/
+void testPixelConvert();
+
+
+/**
+ * \brief Compares bit packed selection mask with per pixel reference
+*/
+void testSelectionMask();
+
+
+/**
+ * \brief Checks that tiled texture copies share tiles until they are changed
+*/
+void testTiledTexture();
+
+
+/**
+ * \brief Checks pixels produced by software rasterizer
+*/
+void testSoftwareTarget();
+
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \brief Contains pixel conversion tests
+*/
+
+
+#include "common/pixel_convert.hpp"
+#include "common/utils.hpp"
+#include "test.hpp"
+
+
+/// Amount of pixels in test array, covers AVX2 groups, SSE2 groups and scalar tail
+const size_t PIXEL_COUNT = 8 * 4 + 4 + 3;
+
+/// Amount of random arrays checked by every test
+const size_t ARRAY_COUNT = 64;
+
+
+/// Function that converts colors to colors
+typedef void (*ColorConversion)(plug::Color *dst, const plug::Color *src, size_t count);
+
+
+/**
+ * \brief Fills colors with random values including transparent and opaque ones
+*/
+static void fillRandom(plug::Color *colors, size_t count);
+
+
+/**
+ * \brief Checks that conversion of whole array equals conversion of every pixel alone
+ * \note Single pixel is always converted by scalar code
+*/
+static void checkColorConversion(ColorConversion conversion);
+
+
+// ============================================================================
+
+
+void testPixelConvert() {
+    checkColorConversion(premultiplyAlpha);
+    checkColorConversion(unpremultiplyAlpha);
+
+    for (size_t i = 0; i < ARRAY_COUNT; i++) {
+        plug::Color colors[PIXEL_COUNT], result[PIXEL_COUNT], expected[PIXEL_COUNT];
+        uint8_t bytes[PIXEL_COUNT * 4];
+
+        fillRandom(colors, PIXEL_COUNT);
+
+        convertColorsToBGRA(bytes, colors, PIXEL_COUNT);
+
+        for (size_t j = 0; j < PIXEL_COUNT; j++) {
+            CHECK(bytes[j * 4 + 0] == colors[j].b && bytes[j * 4 + 1] == colors[j].g);
+            CHECK(bytes[j * 4 + 2] == colors[j].r && bytes[j * 4 + 3] == colors[j].a);
+        }
+
+        convertBGRAToColors(result, bytes, PIXEL_COUNT);
+
+        for (size_t j = 0; j < PIXEL_COUNT; j++) {
+            convertBGRAToColors(expected + j, bytes + j * 4, 1);
+
+            CHECK(isEqual(result[j], expected[j]));
+            CHECK(isEqual(result[j], colors[j]));
+        }
+    }
+}
+
+
+static void fillRandom(plug::Color *colors, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        colors[i] = plug::Color(getRandom(), getRandom(), getRandom(), getRandom());
+
+        // ZERO AND FULL ALPHA ARE SPECIAL CASES OF PREMULTIPLICATION
+        if (i % 5 == 0) colors[i].a = 0;
+        if (i % 7 == 0) colors[i].a = 255;
+    }
+}
+
+
+static void checkColorConversion(ColorConversion conversion) {
+    for (size_t i = 0; i < ARRAY_COUNT; i++) {
+        plug::Color colors[PIXEL_COUNT], result[PIXEL_COUNT], expected[PIXEL_COUNT];
+
+        fillRandom(colors, PIXEL_COUNT);
+
+        conversion(result, colors, PIXEL_COUNT);
+
+        for (size_t j = 0; j < PIXEL_COUNT; j++) {
+            conversion(expected + j, colors + j, 1);
+            CHECK(isEqual(result[j], expected[j]));
+        }
+    }
+}
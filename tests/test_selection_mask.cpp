@@ -0,0 +1,140 @@
+/**
+ * \file
+ * \brief Contains selection mask tests
+*/
+
+
+#include "canvas/canvas/selection_mask.hpp"
+#include "common/list.hpp"
+#include "test.hpp"
+
+
+/// Amount of random masks checked by every operation
+const size_t MASK_COUNT = 64;
+
+/// The largest mask width, covers AVX2 groups, SSE2 groups and scalar tail of words
+const size_t MAX_MASK_WIDTH = 64 * 7 + 5;
+
+/// The largest mask height
+const size_t MAX_MASK_HEIGHT = 5;
+
+
+/// Operations that change mask
+enum class Operation {
+    UNITE,          ///< unite() with other mask
+    INTERSECT,      ///< intersect() with other mask
+    SUBTRACT,       ///< subtract() other mask
+    INVERT,         ///< invert()
+    FILL,           ///< fill() with true
+};
+
+
+/**
+ * \brief Fills mask and reference with the same random pixels
+*/
+static void fillRandom(SelectionMask &mask, List<bool> &reference);
+
+
+/**
+ * \brief Applies operation to mask and reference and compares them
+*/
+static void checkOperation(Operation operation);
+
+
+/**
+ * \brief Compares runs found by mask with runs of reference
+*/
+static void checkRuns(const SelectionMask &mask, const List<bool> &reference);
+
+
+// ============================================================================
+
+
+void testSelectionMask() {
+    checkOperation(Operation::UNITE);
+    checkOperation(Operation::INTERSECT);
+    checkOperation(Operation::SUBTRACT);
+    checkOperation(Operation::INVERT);
+    checkOperation(Operation::FILL);
+}
+
+
+static void fillRandom(SelectionMask &mask, List<bool> &reference) {
+    // LONG RUNS OF THE SAME VALUE PRODUCE WHOLE ZERO AND WHOLE ONE WORDS
+    bool value = false;
+
+    for (size_t y = 0; y < mask.getHeight(); y++) {
+        for (size_t x = 0; x < mask.getWidth(); x++) {
+            if (getRandom() % 50 == 0) value = !value;
+
+            bool pixel = (getRandom() % 4) ? value : !value;
+
+            mask.setPixel(x, y, pixel);
+            reference[y * mask.getWidth() + x] = pixel;
+        }
+    }
+}
+
+
+static void checkOperation(Operation operation) {
+    for (size_t i = 0; i < MASK_COUNT; i++) {
+        size_t width = getRandom() % MAX_MASK_WIDTH + 1;
+        size_t height = getRandom() % MAX_MASK_HEIGHT + 1;
+
+        SelectionMask mask(width, height), other(width, height);
+        List<bool> reference(width * height, false), other_reference(width * height, false);
+
+        fillRandom(mask, reference);
+        fillRandom(other, other_reference);
+
+        switch (operation) {
+            case Operation::UNITE:      mask.unite(other);      break;
+            case Operation::INTERSECT:  mask.intersect(other);  break;
+            case Operation::SUBTRACT:   mask.subtract(other);   break;
+            case Operation::INVERT:     mask.invert();          break;
+            case Operation::FILL:       mask.fill(true);        break;
+            default:                                            break;
+        }
+
+        for (size_t j = 0; j < width * height; j++) {
+            bool a = reference[j], b = other_reference[j];
+
+            switch (operation) {
+                case Operation::UNITE:      reference[j] = a || b;  break;
+                case Operation::INTERSECT:  reference[j] = a && b;  break;
+                case Operation::SUBTRACT:   reference[j] = a && !b; break;
+                case Operation::INVERT:     reference[j] = !a;      break;
+                case Operation::FILL:       reference[j] = true;    break;
+                default:                                            break;
+            }
+
+            CHECK(mask.getPixel(j % width, j / width) == reference[j]);
+        }
+
+        checkRuns(mask, reference);
+    }
+}
+
+
+static void checkRuns(const SelectionMask &mask, const List<bool> &reference) {
+    size_t width = mask.getWidth();
+
+    for (size_t y = 0; y < mask.getHeight(); y++) {
+        const bool *row = &reference[y * width];
+        size_t x = 0, begin = 0, end = 0;
+
+        while (mask.findRun(x, y, begin, end)) {
+            CHECK(x <= begin && begin < end && end <= width);
+            if (!(x <= begin && begin < end && end <= width)) return;
+
+            // PIXELS BEFORE RUN ARE NOT SELECTED, RUN ENDS AT NOT SELECTED PIXEL OR ROW END
+            for (size_t i = x; i < begin; i++) CHECK(!row[i]);
+            for (size_t i = begin; i < end; i++) CHECK(row[i]);
+            CHECK(end == width || !row[end]);
+
+            x = end;
+        }
+
+        for (size_t i = x; i < width; i++) CHECK(!row[i]);
+    }
+}
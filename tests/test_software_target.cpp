@@ -0,0 +1,119 @@
+/**
+ * \file
+ * \brief Contains software rasterizer tests
+*/
+
+
+#include "common/utils.hpp"
+#include "widget/software_target.hpp"
+#include "test.hpp"
+
+
+/// Side of square target
+const size_t TARGET_SIZE = 80;
+
+
+/**
+ * \brief Returns quad with vertex color and texture coordinates from (0, 0) to tex_size
+*/
+static plug::VertexArray createQuad(const Rect &rect, const plug::Color &color, const plug::Vec2d &tex_size);
+
+
+/**
+ * \brief Checks that pixels inside rectangle have one color and pixels outside have another
+*/
+static void checkRect(const SoftwareRenderTarget &target, const Rect &rect, const plug::Color &inside, const plug::Color &outside);
+
+
+// ============================================================================
+
+
+void testSoftwareTarget() {
+    plug::Color transparent(0, 0, 0, 0), black(0, 0, 0), red(255, 0, 0), green(0, 255, 0);
+
+    SoftwareRenderTarget target;
+    target.create(TARGET_SIZE, TARGET_SIZE);
+
+    checkRect(target, Rect(), transparent, transparent);
+
+    // PIXEL CENTERS ARE SAMPLED, SO ALIGNED QUAD COVERS EXACTLY ITS PIXELS
+    Rect quad(plug::Vec2d(8, 8), plug::Vec2d(50, 40));
+    target.draw(createQuad(quad, red, plug::Vec2d()));
+
+    checkRect(target, quad, red, transparent);
+
+    // CLEAR IS LIMITED BY CLIP
+    target.clear(transparent);
+
+    Rect clip(plug::Vec2d(0, 0), plug::Vec2d(TARGET_SIZE, 30));
+    target.pushClip(clip);
+    target.clear(black);
+    target.popClip();
+
+    checkRect(target, clip, black, transparent);
+
+    // TRIANGLES WITH SHARED EDGE COVER EVERY PIXEL ONCE, SO TRANSLUCENT COLOR IS BLENDED ONCE
+    target.clear(black);
+
+    plug::Color translucent(255, 255, 255, 128);
+    plug::VertexArray triangles(plug::Triangles, 0);
+
+    triangles.appendVertex(plug::Vertex(plug::Vec2d(3, 5), translucent));
+    triangles.appendVertex(plug::Vertex(plug::Vec2d(71, 5), translucent));
+    triangles.appendVertex(plug::Vertex(plug::Vec2d(3, 66), translucent));
+    triangles.appendVertex(plug::Vertex(plug::Vec2d(71, 5), translucent));
+    triangles.appendVertex(plug::Vertex(plug::Vec2d(71, 66), translucent));
+    triangles.appendVertex(plug::Vertex(plug::Vec2d(3, 66), translucent));
+
+    target.draw(triangles);
+
+    checkRect(target, Rect(plug::Vec2d(3, 5), plug::Vec2d(68, 61)), plug::Color(128, 128, 128), black);
+
+    // UNSCALED TEXTURE IS COPIED TEXEL BY TEXEL
+    plug::Texture texture(6, 4);
+    for (size_t i = 0; i < texture.width * texture.height; i++)
+        texture.data[i] = plug::Color(getRandom(), getRandom(), getRandom());
+
+    plug::Vec2d position(37, 41);
+    target.draw(createQuad(Rect(position, plug::Vec2d(6, 4)), plug::Color(), plug::Vec2d(6, 4)), texture);
+
+    for (size_t y = 0; y < texture.height; y++)
+        for (size_t x = 0; x < texture.width; x++)
+            CHECK(isEqual(target.getPixel(position.x + x, position.y + y), texture.getPixel(x, y)));
+
+    // ASSEMBLED TEXTURE FOLLOWS LATER DRAWS
+    target.getTexture();
+    target.draw(createQuad(Rect(plug::Vec2d(60, 60), plug::Vec2d(10, 10)), green, plug::Vec2d()));
+
+    const plug::Texture &result = target.getTexture();
+    for (size_t y = 0; y < TARGET_SIZE; y++)
+        for (size_t x = 0; x < TARGET_SIZE; x++)
+            CHECK(isEqual(result.getPixel(x, y), target.getPixel(x, y)));
+}
+
+
+static plug::VertexArray createQuad(const Rect &rect, const plug::Color &color, const plug::Vec2d &tex_size) {
+    plug::VertexArray array(plug::Quads, 0);
+
+    plug::Vec2d end = rect.getEnd();
+
+    array.appendVertex(plug::Vertex(rect.position, color, plug::Vec2d()));
+    array.appendVertex(plug::Vertex(plug::Vec2d(end.x, rect.position.y), color, plug::Vec2d(tex_size.x, 0)));
+    array.appendVertex(plug::Vertex(end, color, tex_size));
+    array.appendVertex(plug::Vertex(plug::Vec2d(rect.position.x, end.y), color, plug::Vec2d(0, tex_size.y)));
+
+    return array;
+}
+
+
+static void checkRect(const SoftwareRenderTarget &target, const Rect &rect, const plug::Color &inside, const plug::Color &outside) {
+    plug::Vec2d end = rect.getEnd();
+
+    for (size_t y = 0; y < TARGET_SIZE; y++) {
+        for (size_t x = 0; x < TARGET_SIZE; x++) {
+            bool is_inside = x >= rect.position.x && x < end.x && y >= rect.position.y && y < end.y;
+
+            CHECK(isEqual(target.getPixel(x, y), (is_inside) ? inside : outside));
+        }
+    }
+}
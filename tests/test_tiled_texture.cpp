@@ -0,0 +1,85 @@
+/**
+ * \file
+ * \brief Contains tiled texture tests
+*/
+
+
+#include "common/utils.hpp"
+#include "widget/tiled_texture.hpp"
+#include "test.hpp"
+
+
+/// Texture width that ends with partial tile
+const size_t TEXTURE_WIDTH = TEXTURE_TILE_SIZE * 2 + 44;
+
+/// Texture height that ends with partial tile
+const size_t TEXTURE_HEIGHT = TEXTURE_TILE_SIZE + 72;
+
+
+/**
+ * \brief Returns true if textures use the same memory for tile containing pixel
+*/
+static bool isShared(const TiledTexture &a, const TiledTexture &b, size_t x, size_t y);
+
+
+// ============================================================================
+
+
+void testTiledTexture() {
+    plug::Color red(255, 0, 0), blue(0, 0, 255), green(0, 255, 0);
+
+    TiledTexture texture(TEXTURE_WIDTH, TEXTURE_HEIGHT, red);
+    TiledTexture copy(texture);
+
+    CHECK(copy.getColumns() == 3 && copy.getRows() == 2);
+
+    for (size_t row = 0; row < texture.getRows(); row++) {
+        for (size_t column = 0; column < texture.getColumns(); column++) {
+            CHECK(isShared(texture, copy, column * TEXTURE_TILE_SIZE, row * TEXTURE_TILE_SIZE));
+            CHECK(texture.getStamp(column, row) == copy.getStamp(column, row));
+        }
+    }
+
+    // WRITE TO COPY COPIES ONLY ONE TILE AND LEAVES ORIGINAL UNCHANGED
+    size_t stamp = texture.getStamp(0, 0);
+    copy.setPixel(10, 10, blue);
+
+    CHECK(isEqual(copy.getPixel(10, 10), blue));
+    CHECK(isEqual(texture.getPixel(10, 10), red));
+    CHECK(!isShared(texture, copy, 0, 0));
+    CHECK(isShared(texture, copy, TEXTURE_TILE_SIZE, 0));
+    CHECK(texture.getStamp(0, 0) == stamp);
+    CHECK(copy.getStamp(0, 0) != stamp);
+
+    // FILL OF ORIGINAL DOES NOT REACH COPY
+    texture.fill(0, 0, TEXTURE_WIDTH, TEXTURE_HEIGHT, green);
+
+    CHECK(isEqual(texture.getPixel(TEXTURE_WIDTH - 1, TEXTURE_HEIGHT - 1), green));
+    CHECK(isEqual(copy.getPixel(TEXTURE_WIDTH - 1, TEXTURE_HEIGHT - 1), red));
+
+    // WRITE AND COPY ACROSS TILE BORDERS ARE SYMMETRIC
+    const size_t x = TEXTURE_TILE_SIZE - 3, y = TEXTURE_TILE_SIZE - 2, width = 7, height = 5;
+    plug::Color written[width * height], read[width * height];
+
+    for (size_t i = 0; i < width * height; i++)
+        written[i] = plug::Color(getRandom(), getRandom(), getRandom(), getRandom());
+
+    texture.write(written, x, y, width, height);
+    texture.copyTo(read, x, y, width, height);
+
+    for (size_t i = 0; i < width * height; i++) {
+        CHECK(isEqual(read[i], written[i]));
+        CHECK(isEqual(texture.getPixel(x + i % width, y + i / width), written[i]));
+        CHECK(isEqual(copy.getPixel(x + i % width, y + i / width), red));
+    }
+
+    // ASSIGNMENT SHARES TILES AGAIN
+    copy = texture;
+    CHECK(isShared(texture, copy, 0, 0));
+    CHECK(isEqual(copy.getPixel(x, y), written[0]));
+}
+
+
+static bool isShared(const TiledTexture &a, const TiledTexture &b, size_t x, size_t y) {
+    return a.getRow(x, y) == b.getRow(x, y);
+}